@@ -0,0 +1,101 @@
+// Load-time benchmark for BookingManager::loadBookingsFromFile.
+//
+// Writes a bookings.json with each requested number of bookings (10k, 100k
+// and 1M by default, or the counts given on the command line) into a
+// scratch directory, loads it and reports the time per booking. Linear
+// loading shows up as a flat per-booking time across sizes.
+//
+//   booking_load_benchmark [count ...]
+
+#include "BookingManager.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <vector>
+
+static const char* SCRATCH_DIR = "booking_load_benchmark_data";
+
+static bool writeBookingsFile(const char* filename, int count) {
+    FILE* file = std::fopen(filename, "wb");
+    if (!file) return false;
+
+    std::fprintf(file, "{\n  \"bookings\": [\n");
+    for (int i = 0; i < count; i++) {
+        int bookingId = 1000 + i;
+        std::fprintf(file,
+                     "    {\n"
+                     "      \"bookingId\": %d,\n"
+                     "      \"pnr\": \"B%05d\",\n"
+                     "      \"passengerName\": \"Passenger %d\",\n"
+                     "      \"flightNumber\": \"BM%d\",\n"
+                     "      \"origin\": \"DEL\",\n"
+                     "      \"destination\": \"BOM\",\n"
+                     "      \"departureDate\": \"2027-01-01\",\n"
+                     "      \"departureTime\": \"08:00\",\n"
+                     "      \"seatNumber\": \"%d%c\",\n"
+                     "      \"cabinClass\": \"economy\",\n"
+                     "      \"totalPrice\": %d.50,\n"
+                     "      \"bookingStatus\": \"confirmed\",\n"
+                     "      \"bookingDate\": \"2026-10-01\",\n"
+                     "      \"bookingTime\": \"10:00\"\n"
+                     "    }%s\n",
+                     bookingId, i % 100000, i, i / 180, (i % 180) / 6 + 1, 'A' + i % 6,
+                     300 + i % 500, i < count - 1 ? "," : "");
+    }
+    std::fprintf(file, "  ],\n  \"nextBookingId\": %d\n}\n", 1000 + count);
+    return std::fclose(file) == 0;
+}
+
+static bool runSize(int count) {
+    char filename[128];
+    std::snprintf(filename, sizeof(filename), "%s/bookings_%d.json", SCRATCH_DIR, count);
+    if (!writeBookingsFile(filename, count)) {
+        std::cout << "Error: Cannot write " << filename << std::endl;
+        return false;
+    }
+    std::uintmax_t fileBytes = std::filesystem::file_size(filename);
+
+    // The loader reports progress on std::cout; keep it out of the results
+    BookingManager manager;
+    std::cout.setstate(std::ios::failbit);
+    auto start = std::chrono::steady_clock::now();
+    bool loaded = manager.loadBookingsFromFile(filename);
+    double elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::cout.clear();
+
+    if (!loaded || manager.getBookingCount() != count) {
+        std::cout << "Error: Loaded " << manager.getBookingCount() << " of " << count << " bookings." << std::endl;
+        return false;
+    }
+
+    std::printf("%9d bookings  %8.1f MB  %9.1f ms  %7.0f ns/booking  %6.1f MB/s\n",
+                count, fileBytes / 1e6, elapsedMs, elapsedMs * 1e6 / count,
+                fileBytes / 1e3 / elapsedMs);
+    return true;
+}
+
+int main(int argc, char** argv) {
+    std::vector<int> counts;
+    for (int i = 1; i < argc; i++) {
+        int count = std::atoi(argv[i]);
+        if (count > 0) counts.push_back(count);
+    }
+    if (counts.empty()) {
+        counts = {10000, 100000, 1000000};
+    }
+
+    std::filesystem::create_directories(SCRATCH_DIR);
+
+    bool ok = true;
+    for (int count : counts) {
+        if (!runSize(count)) {
+            ok = false;
+            break;
+        }
+    }
+
+    std::filesystem::remove_all(SCRATCH_DIR);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,44 @@
+#ifndef ATOMICSEATMAP_H
+#define ATOMICSEATMAP_H
+
+#include "SeatOccupancy.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+
+// In-process seat claims for concurrent booking threads. Each flight has
+// an array of atomic bitmap words and a claim is a compare-and-swap on one
+// word, so two threads racing for the same seat never block each other and
+// the loser learns immediately that the seat is taken. The flight table is
+// only written when a flight is first seen; claims take it shared.
+class AtomicSeatMap {
+public:
+    AtomicSeatMap();
+    ~AtomicSeatMap();
+
+    // Adds a flight seeded with its already-occupied seats (no-op if present)
+    void addFlight(const char* flightNumber, const std::uint64_t* seedWords);
+    bool hasFlight(const char* flightNumber) const;
+
+    // False if the seat is already claimed, invalid, or the flight is unknown
+    bool tryClaim(const char* flightNumber, const char* seatNumber);
+    void release(const char* flightNumber, const char* seatNumber);
+    bool isClaimed(const char* flightNumber, const char* seatNumber) const;
+    int getClaimedCount(const char* flightNumber) const;
+
+private:
+    struct FlightSeats {
+        std::atomic<std::uint64_t> words[SeatOccupancy::WORD_COUNT];
+    };
+
+    mutable std::shared_mutex tableMutex;
+    std::unordered_map<std::string, std::unique_ptr<FlightSeats>> flights;
+
+    FlightSeats* findFlight(const char* flightNumber) const;
+    static bool seatBit(const char* seatNumber, int& word, std::uint64_t& mask);
+};
+
+#endif // ATOMICSEATMAP_H
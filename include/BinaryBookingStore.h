@@ -0,0 +1,115 @@
+#ifndef BINARYBOOKINGSTORE_H
+#define BINARYBOOKINGSTORE_H
+
+#include "Booking.h"
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// On-disk layout of one booking. Field widths match Booking so a record
+// converts without truncation; every write bumps the record's version.
+struct BookingRecord {
+    std::uint32_t version;
+    std::uint32_t flags;
+    std::int32_t bookingId;
+    std::int32_t reserved;
+    double totalPrice;
+    char pnr[10];
+    char passengerName[50];
+    char flightNumber[10];
+    char origin[10];
+    char destination[10];
+    char departureDate[15];
+    char departureTime[10];
+    char seatNumber[5];
+    char cabinClass[15];
+    char bookingStatus[20];
+    char bookingDate[15];
+    char bookingTime[10];
+};
+
+// Every write also logs its slot in changedSlots, a ring indexed by
+// changeCount, so other processes can catch up by re-reading just the
+// slots written since they last looked.
+static const int BOOKING_STORE_CHANGE_LOG_SIZE = 1024;
+
+struct BookingStoreHeader {
+    char magic[8];
+    std::uint32_t formatVersion;
+    std::uint32_t recordSize;
+    std::int32_t recordCount;
+    std::int32_t capacity;
+    std::int32_t nextBookingId;
+    std::int32_t reserved0;
+    std::uint64_t changeCount;      // record writes since the store was created
+    char reserved[24];
+    std::int32_t changedSlots[BOOKING_STORE_CHANGE_LOG_SIZE];
+};
+
+// Memory-mapped array of fixed-width booking records (data/bookings.bin).
+// Updates are written in place, so a change touches one record instead
+// of rewriting the whole file.
+class BinaryBookingStore {
+public:
+    static const std::uint32_t RECORD_LIVE = 1;
+    static const std::uint32_t RECORD_CANCELLED = 2;
+
+    BinaryBookingStore();
+    ~BinaryBookingStore();
+
+    bool open(const char* filename);
+    bool create(const char* filename);
+    void close();
+    bool isOpen() const;
+    bool sync();
+
+    // Record access
+    int getRecordCount();
+    bool readRecord(int slot, Booking& booking);
+    bool storeBooking(const Booking& booking);
+    bool removeBooking(int bookingId);
+
+    int getNextBookingId();
+    void setNextBookingId(int id);
+
+    // Change log: slots written by changes [since, getChangeCount()). Returns
+    // false once more changes than the log holds have happened since then.
+    std::uint64_t getChangeCount();
+    bool getChangedSlots(std::uint64_t since, std::vector<int>& slots);
+    int getRecordBookingId(int slot);   // live or cancelled, -1 if out of range
+
+private:
+    static const int INITIAL_CAPACITY = 1024;
+
+#ifdef _WIN32
+    void* fileHandle;
+    void* mappingHandle;
+#else
+    int fd;
+#endif
+    char* base;
+    std::size_t mappedSize;
+    std::unordered_map<int, int> slotById;
+    int indexedCount;
+
+    bool openFile(const char* filename, bool truncate);
+    bool mapFile(std::size_t size);
+    void unmapFile();
+    bool resizeFile(std::size_t size);
+    bool ensureCapacity(int slots);
+    std::size_t fileSize();
+    bool initializeHeader();
+    bool upgradeFromVersion1(std::size_t size);
+    void logChange(int slot);
+    bool refreshMapping();
+    void indexNewRecords();
+
+    BookingStoreHeader* header();
+    BookingRecord* record(int slot);
+    static std::size_t fileSizeFor(int capacity);
+    static void toRecord(const Booking& booking, BookingRecord& rec);
+    static void fromRecord(const BookingRecord& rec, Booking& booking);
+};
+
+#endif // BINARYBOOKINGSTORE_H
@@ -13,6 +13,7 @@ private:
     char origin[10];
     char destination[10];
     char departureDate[15];
+    int departureDay;       // departureDate as an epoch day, parsed when it is set
     char departureTime[10];
     char seatNumber[5];
     char cabinClass[15];
@@ -58,6 +59,7 @@ public:
     const char* getOrigin() const;
     const char* getDestination() const;
     const char* getDepartureDate() const;
+    int getDepartureDay() const;
     const char* getDepartureTime() const;
     const char* getSeatNumber() const;
     const char* getCabinClass() const;
@@ -0,0 +1,111 @@
+#ifndef BOOKINGENGINE_H
+#define BOOKINGENGINE_H
+
+#include "BookingManager.h"
+#include "FlightList.h"
+#include "FileLock.h"
+#include "LockStripes.h"
+#include "AtomicSeatMap.h"
+#include "PaymentProcessor.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+struct BookingRequest {
+    char passengerName[50];
+    char flightNumber[10];
+    char seatNumber[5];
+    char cabinClass[15];
+    double totalPrice;      // charged and stored; 0 stores the base fare plus $50
+    int paymentMethod;      // PaymentRequest::Method, used when the engine takes payment
+};
+
+struct BookingResult {
+    enum Status { BOOKED, SEAT_TAKEN, FLIGHT_NOT_FOUND, PAYMENT_DECLINED, FAILED };
+    Status status;
+    int bookingId;
+};
+
+// Fixed-size worker pool for booking requests. Requests are queued and each
+// worker takes up to MAX_BATCH of them at a time: seats are claimed
+// lock-free first, then the whole batch is committed under one
+// acquisition of the flight and global locks, with a single catalog
+// reload and save. Requests for a taken seat fail without touching a lock.
+// With a payment processor, a claimed request is charged before it is
+// committed: the worker hands the payment off and moves on, and the
+// completed payment re-enters the queue for the commit step, so no worker
+// waits on the processor. A declined payment gives the seat back, and a
+// paid request that still fails at the commit step is refunded.
+// The BookingManager and FlightList belong to the owner; the engine only
+// touches them under the global lock.
+class BookingEngine {
+public:
+    static const int MAX_BATCH = 32;
+
+    BookingEngine(BookingManager& bookingManager, FlightList& flightList,
+                  FileLock& globalLock, LockStripes& flightLocks, int workerCount,
+                  PaymentProcessor* paymentProcessor = nullptr);
+    ~BookingEngine();
+
+    std::future<BookingResult> submit(const BookingRequest& request);
+
+    // Finishes every queued request and pending payment, then stops the workers
+    void shutdown();
+
+    // Throughput statistics
+    long long getSubmittedCount() const { return submitted.load(); }
+    long long getBookedCount() const { return booked.load(); }
+    long long getFailedCount() const { return failed.load(); }
+    double getBookingsPerSecond() const;
+
+    static int defaultWorkerCount();
+
+private:
+    struct PendingBooking {
+        BookingRequest request;
+        std::promise<BookingResult> result;
+        bool paid;                 // payment finished; ready for the commit step
+        PaymentResult payment;
+    };
+
+    BookingManager& bookingManager;
+    FlightList& flightList;
+    FileLock& globalLock;
+    LockStripes& flightLocks;
+    PaymentProcessor* paymentProcessor;
+
+    std::mutex queueMutex;
+    std::condition_variable queueReady;
+    std::deque<std::unique_ptr<PendingBooking>> queue;
+    bool stopping;
+    int paymentsInFlight;      // owned by the processor until their callback requeues them
+    int refundsInFlight;       // shutdown waits for these callbacks too
+    std::vector<std::thread> workers;
+
+    // Claims are made before any lock is taken
+    AtomicSeatMap seatClaims;
+
+    std::atomic<long long> submitted;
+    std::atomic<long long> booked;
+    std::atomic<long long> failed;
+    std::chrono::steady_clock::time_point firstSubmit;
+    std::atomic<long long> lastCompletionMicros;   // since firstSubmit
+
+    void workerLoop();
+    void processBatch(std::vector<std::unique_ptr<PendingBooking>>& batch);
+    void submitPayment(std::unique_ptr<PendingBooking> pending);
+    void paymentCompleted(PendingBooking* pending, const PaymentResult& payment);
+    void refundPayment(const PendingBooking& pending);
+    void refundCompleted(const PaymentResult& refund);
+    bool prepareFlight(const char* flightNumber);
+    void commitBatch(std::vector<PendingBooking*>& claimed, std::vector<BookingResult>& results);
+    void complete(PendingBooking& pending, const BookingResult& result);
+};
+
+#endif // BOOKINGENGINE_H
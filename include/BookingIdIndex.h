@@ -0,0 +1,34 @@
+#ifndef BOOKINGIDINDEX_H
+#define BOOKINGIDINDEX_H
+
+#include <vector>
+
+// Direct-addressed table from booking ID to its slot in the booking array.
+// IDs are handed out sequentially, so the table stays dense and a lookup
+// is a single array index. Cancelled IDs keep a tombstone so callers can
+// tell "never existed" apart from "already cancelled".
+class BookingIdIndex {
+public:
+    static const int NO_SLOT = -1;
+    static const int CANCELLED = -2;
+
+    BookingIdIndex();
+    ~BookingIdIndex();
+
+    void setSlot(int bookingId, int slot);
+    void markCancelled(int bookingId);
+    int findSlot(int bookingId) const;   // NO_SLOT or CANCELLED if not live
+    bool isCancelled(int bookingId) const;
+
+    // Bulk rebuild: size the table once for the ID range, then fill it
+    void reset(int minId, int maxId);
+    void clear();
+
+private:
+    std::vector<int> slots;
+    int baseId;
+
+    bool ensureRange(int bookingId);
+};
+
+#endif // BOOKINGIDINDEX_H
@@ -2,37 +2,126 @@
 #define BOOKINGMANAGER_H
 
 #include "Booking.h"
+#include "BinaryBookingStore.h"
+#include "ChunkedArray.h"
+#include "PnrIndex.h"
+#include "PnrCodec.h"
+#include "BookingIdIndex.h"
+#include "SeatOccupancy.h"
+#include "FlightBookingIndex.h"
+#include "SeatHoldTable.h"
+#include "IdAllocator.h"
+#include "JournalFile.h"
+#include <random>
+#include <vector>
+
+class JsonStreamReader;
+class FileLock;
 
 class BookingManager {
 private:
-    static const int MAX_BOOKINGS = 100;
-    Booking bookings[MAX_BOOKINGS];
-    int bookingCount;
-    int nextBookingId;
+    // Chunked storage: bookings never move, and a cancellation leaves a
+    // hole until the next full load, so slot indices stay valid
+    ChunkedArray<Booking> bookings;
+
+    // Slots of the live bookings in order, so getBooking(index) stays dense
+    // over the holes; rebuilt on first use after bookings are added or removed
+    mutable std::vector<int> liveSlots;
+    mutable bool liveSlotsStale;
+    int nextBookingId;              // one past the highest ID seen in storage
+
+    // New IDs come from blocks leased against data/bookings.ids, so creating
+    // a booking never waits on other writers for its ID
+    IdAllocator idAllocator;
+
+    // PNRs encode their booking ID, so lookups decode them directly; the
+    // hash index only holds legacy PNRs from before the codec
+    PnrCodec pnrCodec;
+
+    // Lookup indexes, kept in step with every mutation and rebuilt on load
+    PnrIndex pnrIndex;
+    BookingIdIndex idIndex;
+    SeatOccupancy seatOccupancy;
+    FlightBookingIndex flightIndex;
+
+    // Seat holds are journaled like bookings so every process honours them
+    SeatHoldTable seatHolds;
+    std::mt19937_64 holdIdSource;
+
+    // Write-ahead journal: every mutation is appended as one record and
+    // folded back into the snapshot once the journal holds at least
+    // CHECKPOINT_INTERVAL records and as many records as there are bookings,
+    // which keeps the rewrite cost amortized O(1) per mutation.
+    static const int CHECKPOINT_INTERVAL = 500;
+    static const int MAX_PATH_LENGTH = 260;
+    char snapshotPath[MAX_PATH_LENGTH];
+    char journalPath[MAX_PATH_LENGTH];
+    JournalFile journalFile;        // opened on the first append; every record is synced to disk
+    int journalRecordCount;
+
+    // How far this process has read the journal. A checkpoint starts the
+    // journal over with a new generation header, so a refresh can replay
+    // just the tail while the generation is unchanged.
+    long long journalOffset;
+    int journalGeneration;
+
+    // Alternative backend: memory-mapped fixed-width records (*.bin)
+    BinaryBookingStore binaryStore;
+    bool useBinaryStore;
+    std::uint64_t binaryChangeCount;   // store changes already applied in memory
+
+    // Cross-process lock around every read or write of the booking files.
+    // Other processes append to the same journal, so it is held exclusively
+    // for ID allocation, journal appends and checkpoints; read-only refreshes
+    // take it shared.
+    FileLock* storageLock;
 
     // Private helper methods (Existing)
     void generatePnr(char* pnr, int bookingId);
+    bool isLegacyPnr(const Booking& booking) const;
     Booking* findBookingById(int bookingId);
     void updateBookingStatus(int bookingId, const char* status);
     double calculateCancellationFee(int bookingId, int daysUntilDeparture);
     void getCurrentDateTime(char* date, char* time);
+    void appendBooking(const Booking& booking);
+    void occupySeat(const char* flightNumber, const char* seatNumber);
+    void removeBookingAt(int index);
+    void rebuildIndexes();
+
+    // Storage helpers
+    bool lockStorage();
+    void unlockStorage(bool taken);
+    bool lockStorageShared();
+    void unlockStorageShared(bool taken);
+    bool loadBookingsFromStorage(const char* filename, bool repairTail);
+    bool saveBookingsToStorage(const char* filename);
+    bool persistMutation(const char* op, const Booking& booking);
+    static bool isBinaryStorePath(const char* filename);
+    bool loadBinaryStore(const char* filename);
+    bool saveBinaryStore(const char* filename);
+    bool catchUpWithBinaryStore();
+
+    // Journal helpers
+    void setStoragePaths(const char* filename);
+    bool appendJournalRecord(const char* op, const Booking& booking);
+    bool appendHoldRecord(const SeatHold& hold);
+    bool appendReleaseRecord(std::uint64_t holdId);
+    bool writeJournalRecord(const std::string& record);
+    bool openJournal();
+    bool replayHoldRecord(const char* record);
+    static long long currentEpochSeconds();
+    int replayJournal(const char* filename, long long fromOffset, bool repairTail);
+    int readJournalGeneration();
+    bool canReplayJournalTail();
+    bool catchUpWithStorage();
+    void applyJournalRecord(const char* op, const Booking& booking);
+    bool loadSnapshotFromFile(const char* filename);
 
     // Private helper methods (New) - No STL dependencies
-    bool parseJsonStringBasic(const char* json, const char* key, char* result, int maxLen);
-    bool parseJsonIntBasic(const char* json, const char* key, int& result);
-    bool parseJsonDoubleBasic(const char* json, const char* key, double& result);
     bool containsIgnoreCase(const char* str, const char* substr);
 
-    // Custom JSON parsing helper functions
-    char* findStringInBuffer(const char* buffer, const char* searchStr);
-    char* findCharInBuffer(const char* buffer, char ch);
-    char* findMatchingBrace(const char* start);
-    int parseIntFromBuffer(const char* buffer);
-    double parseDoubleFromBuffer(const char* buffer);
-    void copyStringN(char* dest, const char* src, int n);
-    bool parseJsonStringFromObject(const char* json, const char* key, char* result, int maxLen);
-    int parseJsonIntFromObject(const char* json, const char* key);
-    double parseJsonDoubleFromObject(const char* json, const char* key);
+    // Streaming JSON helpers
+    bool readBookingObject(JsonStreamReader& reader, Booking& booking, char* op, int opLen);
 
 public:
     BookingManager();
@@ -55,6 +144,20 @@ public:
     // Search methods
     int findBookingByPnr(const char* pnr);
     void searchBookingsByFlight(const char* flightNumber);
+    bool isSeatOccupied(const char* flightNumber, const char* seatNumber) const;
+    bool isSeatOccupied(const char* flightNumber, int row, int column) const;
+    int getOccupiedSeatCount(const char* flightNumber) const;
+    void getOccupiedSeatWords(const char* flightNumber, std::uint64_t* words) const;
+    const std::vector<int>* getBookingIdsForFlight(const char* flightNumber) const;
+
+    // Seat holds: a hold keeps a seat from other customers until it is
+    // booked, released or its time-to-live runs out
+    std::uint64_t placeSeatHold(const char* flightNumber, const char* seatNumber,
+                                int ttlSeconds, std::uint64_t holdId);
+    void releaseSeatHold(std::uint64_t holdId);
+    bool isSeatHoldActive(std::uint64_t holdId) const;
+    std::uint64_t getSeatHolder(const char* flightNumber, int row, int column) const;
+    bool isSeatAvailable(const char* flightNumber, const char* seatNumber, std::uint64_t ownHoldId) const;
 
     // Utility methods
     bool isValidBookingId(int bookingId);
@@ -67,12 +170,17 @@ public:
     // File operations
     bool saveBookingsToFile(const char* filename);
     bool loadBookingsFromFile(const char* filename);
+    bool reloadBookings();
+    bool refreshBookings();
+    bool checkpoint();
+    void setStorageLock(FileLock* lock);
 
     // Statistics methods
-    int getBookingCount() const { return bookingCount; }
+    int getBookingCount() const { return bookings.size(); }
     double calculateTotalRevenue() const;
 
-    // Public getters to access private data safely
+    // Public getters to access private data safely. getBooking takes an index
+    // below getBookingCount() and covers exactly the live bookings.
     const Booking* getBooking(int index) const;
     const Booking* getBookingById(int bookingId) const;
 };
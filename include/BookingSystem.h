@@ -5,31 +5,58 @@
 #include "FlightList.h"
 #include "UserInput.h"
 #include "StringUtils.h"
+#include "FileLock.h"
+#include "LockStripes.h"
+#include "BookingEngine.h"
+#include "SimulatedPaymentProcessor.h"
+#include "PricingEngine.h"
+#include "ItineraryPlanner.h"
+#include <memory>
+#include <mutex>
 #include <string>
 #include <thread> // Added for concurrency
 #include <vector> // Added for storing threads
 
 class BookingSystem {
 private:
+    static const int SEAT_HOLD_SECONDS = 600;   // how long a selected seat is kept during checkout
+    static const int PAYMENT_LATENCY_MS = 2000;  // simulated processor round trip
+    static const int MAX_CONNECTING_OPTIONS = 5;  // itineraries listed when there is no nonstop
+
     BookingManager bookingManager;
     FlightList flightList;
+    PricingEngine pricingEngine;     // surge rules from data/pricing.json
+    ItineraryPlanner itineraryPlanner;   // connecting flights for routes without a nonstop
     UserInput userInput;
     char passengerName[50];
     char passengerEmail[50];
     char passengerPhone[20];
     char seatNumber[5];
     int selectedFlightIndex;
+    int selectedFlightVersion;       // inventory version the quote and seat map were read at
+    std::vector<std::uint64_t> seatHoldIds;   // one hold per passenger's seat, in passenger order
+    double chargedAmount;            // what processPayment charged; the booking keeps this fare
+    char paymentTransactionId[20];   // refunded if the booking fails after payment
+    std::vector<int> routeMatches;   // flight indices from the last route search
+    FileLock bookingLock;            // short global lock for the shared data files
+    LockStripes flightLocks;         // per-flight locks held for a whole operation
+    SimulatedPaymentProcessor paymentProcessor;     // must outlive the engine
+    std::unique_ptr<BookingEngine> bookingEngine;   // started on first use
+    std::once_flag engineStarted;
 
     // Utility methods
     void acquireLock();
     void releaseLock();
+    void acquireFlightLock(const char* flightNumber);
+    void releaseFlightLock(const char* flightNumber);
+    bool lockFlightOfBooking(int bookingId, char* flightNumber);
     double calculateTotalPrice();
     void showDynamicPricingBreakdown(const Flight* flight, int daysUntilDeparture);
-    double calculateDynamicPrice(const Flight* flight, int daysUntilDeparture);
     int getBookingIdFromInput(const char* input);
     void showSeatMap(const Flight& flight);
     bool isValidSeatNumber(const char* seatNumber);
-    bool isSeatOccupied(const char* seatNumber, const Flight& flight);
+    bool isSeatOccupied(const char* seatNumber, const Flight& flight, std::uint64_t ownHoldId);
+    void releaseSeatHolds();
 
     // Private methods for modification and cancellation
     void processCancellation(int bookingId);
@@ -63,15 +90,18 @@ public:
     // Internal booking process steps
     bool searchFlightsByRoute();
     void displayFlightOptions();
+    bool displayConnectingItineraries();
     int selectFlightFromList();
     void displaySeatAvailability(const Flight* flight);
     bool selectPassengerSeats(const Flight* flight);
     void collectPassengerDetails();
     void reviewBookingDetails();
     bool processPayment();
+    void refundPayment();
     bool generateBookingConfirmation();
 
-    // Concurrency-related function
+    // Concurrency-related functions
+    BookingEngine& getBookingEngine();
     void simulateConcurrentBooking(int threadId, int flightIndex, const char* name, const char* seat);
 };
 
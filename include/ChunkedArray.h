@@ -0,0 +1,66 @@
+#ifndef CHUNKEDARRAY_H
+#define CHUNKEDARRAY_H
+
+#include <memory>
+#include <vector>
+
+// Growable array stored in fixed-size chunks. Growing only allocates a
+// new chunk, so elements are never copied or moved: pointers and indices
+// to them stay valid until clear(). Removing an element leaves a hole
+// that is not reused, so iteration keeps insertion order; iterate up to
+// slotCount() and skip the slots where isLive() is false.
+template <typename T>
+class ChunkedArray {
+public:
+    static const int CHUNK_SHIFT = 12;
+    static const int CHUNK_SIZE = 1 << CHUNK_SHIFT;   // 4096 elements per chunk
+
+    ChunkedArray() : count(0), liveCount(0) {}
+
+    T& operator[](int index) {
+        return chunks[index >> CHUNK_SHIFT][index & (CHUNK_SIZE - 1)];
+    }
+
+    const T& operator[](int index) const {
+        return chunks[index >> CHUNK_SHIFT][index & (CHUNK_SIZE - 1)];
+    }
+
+    int size() const { return liveCount; }        // live elements
+    int slotCount() const { return count; }       // live and removed slots
+    bool isLive(int index) const { return index >= 0 && index < count && live[index]; }
+
+    // The new element's index is slotCount() - 1
+    T& append(const T& value) {
+        if (count == static_cast<int>(chunks.size()) * CHUNK_SIZE) {
+            chunks.emplace_back(new T[CHUNK_SIZE]);
+        }
+        T& slot = (*this)[count];
+        slot = value;
+        live.push_back(true);
+        count++;
+        liveCount++;
+        return slot;
+    }
+
+    // O(1) removal: the slot becomes a hole and no other element moves
+    void removeAt(int index) {
+        if (!isLive(index)) return;
+        live[index] = false;
+        liveCount--;
+    }
+
+    // Chunks are kept so a reload refills them without allocating
+    void clear() {
+        count = 0;
+        liveCount = 0;
+        live.clear();
+    }
+
+private:
+    std::vector<std::unique_ptr<T[]>> chunks;
+    std::vector<bool> live;
+    int count;
+    int liveCount;
+};
+
+#endif // CHUNKEDARRAY_H
@@ -0,0 +1,28 @@
+#ifndef DATE_H
+#define DATE_H
+
+// Calendar arithmetic on "YYYY-MM-DD" dates. A date is parsed once into
+// an epoch day (days since 1970-01-01), after which day differences are
+// plain integer subtraction.
+class Date {
+public:
+    static const int INVALID_DAY = -2147483647 - 1;
+
+    // Epoch day of a proleptic Gregorian date, without branches
+    // (Howard Hinnant's days_from_civil). Valid for years from -2000 on.
+    static int daysFromCivil(int year, int month, int day);
+
+    // Epoch day of "YYYY-MM-DD", INVALID_DAY if the text is not a real date
+    static int parse(const char* text);
+
+    // Minutes after midnight of "HH:MM", -1 if the text is not a valid time
+    static int parseTimeOfDay(const char* text);
+
+    // Today's local date as an epoch day
+    static int today();
+
+    // Whole days from today until epochDay; 0 once the day has come or if it is invalid
+    static int daysUntil(int epochDay);
+};
+
+#endif // DATE_H
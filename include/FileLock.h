@@ -0,0 +1,74 @@
+#ifndef FILELOCK_H
+#define FILELOCK_H
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+// Reader/writer lock shared by threads and processes. Threads in this
+// process queue on a mutex/condition variable; the holder then takes a
+// kernel advisory lock on the lock file (flock, or LockFileEx on Windows)
+// to exclude other processes. Waiters wake as soon as the lock is released,
+// and the kernel drops the lock if the holding process dies, so a crash
+// never leaves the system locked. The lock file itself is never deleted.
+//
+// Shared holders in one process share a single kernel shared lock: the
+// first reader takes it and the last one drops it. Waiting writers block
+// new readers so a steady stream of lookups cannot starve them.
+class FileLock {
+public:
+    static const int WAIT_FOREVER = -1;
+
+    explicit FileLock(const char* path);
+    ~FileLock();
+
+    // Returns false on timeout, on error, or if this thread already holds the lock
+    bool lock(int timeoutMs = WAIT_FOREVER);
+    bool unlock();
+    bool isHeldByCurrentThread();
+
+    // Shared mode for read-only work; fails if this thread holds the lock exclusively
+    bool lockShared(int timeoutMs = WAIT_FOREVER);
+    bool unlockShared();
+
+    // Wait-time statistics
+    long long getLastWaitMicros() const { return lastWaitMicros; }
+    long long getTotalWaitMicros() const { return totalWaitMicros; }
+    int getAcquireCount() const { return acquireCount; }
+
+private:
+    static const int MAX_PATH_LENGTH = 260;
+    static const int MAX_BACKOFF_MS = 50;
+
+    char path[MAX_PATH_LENGTH];
+
+    // In-process ownership
+    std::mutex stateMutex;
+    std::condition_variable released;
+    bool held;
+    std::thread::id owner;
+    int sharedCount;        // threads holding the lock in shared mode
+    int writersWaiting;
+    bool kernelBusy;        // the kernel shared lock is being taken or dropped
+
+#ifdef _WIN32
+    void* fileHandle;
+#else
+    int fd;
+#endif
+
+    long long lastWaitMicros;
+    long long totalWaitMicros;
+    int acquireCount;
+
+    bool openFile();
+    bool lockFile(bool exclusive, int timeoutMs);
+    bool tryLockFile(bool exclusive, bool& wouldBlock);
+    int remainingMillis(int timeoutMs, std::chrono::steady_clock::time_point deadline);
+    void recordWait(std::chrono::steady_clock::time_point start);
+    void unlockFile();
+    void releaseOwnership();
+};
+
+#endif // FILELOCK_H
@@ -4,6 +4,7 @@
 #pragma once
 #include <nlohmann/json.hpp>
 #include "StringUtils.h"
+#include "PricingEngine.h"
 
 class Flight {
 private:
@@ -14,12 +15,24 @@ private:
     char departureTime[20];
     char arrivalTime[20];
     char departureDate[15];
+    int departureDay;       // departureDate as an epoch day, parsed when it is set
     char arrivalDate[15];
     char aircraftType[30];
     double basePrice;
     int totalSeats;
     int availableSeats;
     char duration[10];
+    // Inventory version: bumped on every seat change so a booking can
+    // tell whether the flight moved on since it was read
+    int version;
+
+    // Last price quote. It is dropped when the seat count leaves the range
+    // priced alike, and a lookup checks the table generation and day bucket.
+    mutable PriceQuote cachedQuote;
+    mutable int quoteGeneration;        // 0 when nothing is cached
+    mutable int quoteTimeBucket;
+    mutable int quoteMinAvailable;
+    mutable int quoteMaxAvailable;
 
 public:
     // Constructors and Destructor
@@ -44,6 +57,8 @@ public:
     void setTotalSeats(int total);
     void setAvailableSeats(int available);
     void setDuration(const char* dur);
+    void setVersion(int ver);
+    void bumpVersion();
 
     // Getters
     const char* getAirlineName() const;
@@ -53,15 +68,18 @@ public:
     const char* getDepartureTime() const;
     const char* getArrivalTime() const;
     const char* getDepartureDate() const;
+    int getDepartureDay() const;
     const char* getArrivalDate() const;
     const char* getAircraftType() const;
     double getBasePrice() const;
     int getTotalSeats() const;
     int getAvailableSeats() const;
     const char* getDuration() const;
+    int getVersion() const;
 
     // Pricing and Availability Methods
-    double calculateDynamicPrice(int daysUntilDeparture) const;
+    double calculateDynamicPrice(const PricingEngine& pricing, int daysUntilDeparture) const;
+    const PriceQuote& getPriceQuote(const PricingEngine& pricing, int daysUntilDeparture) const;
     bool hasAvailableSeats() const;
     bool isAvailable() const;  // Added missing method
 
@@ -72,11 +90,6 @@ public:
     // JSON serialization
     void toJson(nlohmann::json& j) const;
     void fromJson(const nlohmann::json& j);
-
-private:
-    // Helper methods for internal calculations
-    double calculateSurgePrice() const;
-    double calculateTimeBasedPrice(int daysUntilDeparture) const;
 };
 
 
@@ -0,0 +1,27 @@
+#ifndef FLIGHTBOOKINGINDEX_H
+#define FLIGHTBOOKINGINDEX_H
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Secondary index from flight number to the IDs of the bookings on it,
+// so per-flight queries only touch that flight's bookings.
+class FlightBookingIndex {
+public:
+    FlightBookingIndex();
+    ~FlightBookingIndex();
+
+    void add(const char* flightNumber, int bookingId);
+    void remove(const char* flightNumber, int bookingId);
+
+    // nullptr when the flight has no bookings
+    const std::vector<int>* getBookingIds(const char* flightNumber) const;
+
+    void clear();
+
+private:
+    std::unordered_map<std::string, std::vector<int>> bookingsByFlight;
+};
+
+#endif // FLIGHTBOOKINGINDEX_H
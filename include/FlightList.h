@@ -7,12 +7,20 @@
 #include <nlohmann/json.hpp>
 #include "StringUtils.h"
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 class FlightList {
 private:
-    static const int MAX_FLIGHTS = 50;
-    Flight flights[MAX_FLIGHTS];
-    int flightCount;
+    std::vector<Flight> flights;
+
+    // (origin, destination, date) -> indices into flights, maintained by addFlight
+    std::unordered_map<std::string, std::vector<int>> routeIndex;
+
+    // Bumped whenever flights are added or cleared, which includes every load
+    int changeCount;
+
+    static std::string makeRouteKey(const char* origin, const char* destination, const char* departureDate);
 
 public:
     FlightList();
@@ -25,13 +33,20 @@ public:
     int getCount() const;
     int getFlightCount() const;
     void clearFlights();
+    void reserveFlights(int count);
     int getIndexOfFlight(const char* flightNumber) const;
 
+    // Lets derived data (e.g. the itinerary graph) tell whether the catalog
+    // changed. Seat counts are only edited in place right after a reload.
+    int getChangeCount() const { return changeCount; }
+
     // Correctly declared public method
     Flight* getFlightByNumber(const char* flightNumber);
 
     // Search methods
     int searchByRoute(const char* origin, const char* destination, const char* departureDate);
+    int searchByRoute(const char* origin, const char* destination, const char* departureDate,
+                      std::vector<int>& matches);
 
     // Display methods
     void displayFlights() const;
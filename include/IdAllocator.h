@@ -0,0 +1,53 @@
+#ifndef IDALLOCATOR_H
+#define IDALLOCATOR_H
+
+#include "FileLock.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+// Booking ID allocator shared by threads and processes. IDs are leased in
+// blocks from a high-water mark file (data/bookings.ids): taking a block
+// moves the mark forward under a file lock, so two processes never receive
+// the same range. Inside a block an ID costs one compare-and-swap on an
+// atomic window, with no lock at all. IDs left unused in a block when the
+// process exits are skipped, never handed out twice.
+class IdAllocator {
+public:
+    static const int DEFAULT_BLOCK_SIZE = 32;
+
+    explicit IdAllocator(int blockSize = DEFAULT_BLOCK_SIZE);
+    ~IdAllocator();
+
+    // Points the allocator at a high-water mark file; a new file drops the current block
+    void setPath(const char* highWaterPath);
+
+    // Next free ID; -1 on error. A new block never starts below floor, which
+    // carries data from before the mark file existed over to the allocator.
+    int allocate(int floor);
+
+    int getLeaseCount() const { return leaseCount.load(); }
+
+private:
+    static const int MAX_PATH_LENGTH = 260;
+
+    char path[MAX_PATH_LENGTH];
+    std::unique_ptr<FileLock> leaseLock;
+    int blockSize;
+
+    // Current block: next ID in the low 32 bits, end (exclusive) in the high 32 bits
+    std::atomic<std::uint64_t> window;
+    std::mutex leaseMutex;
+    std::atomic<int> leaseCount;
+
+    bool leaseBlock(int floor);
+    bool readHighWater(int& mark);
+    bool writeHighWater(int mark);
+
+    static std::uint64_t packWindow(std::uint32_t next, std::uint32_t end) {
+        return (static_cast<std::uint64_t>(end) << 32) | next;
+    }
+};
+
+#endif // IDALLOCATOR_H
@@ -0,0 +1,110 @@
+#ifndef ITINERARYPLANNER_H
+#define ITINERARYPLANNER_H
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class FlightList;
+class PricingEngine;
+
+// One way to get from origin to destination: a nonstop flight or a chain of
+// connecting flights, each leaving at least the minimum connection time after
+// the previous one lands.
+struct Itinerary {
+    static const int MAX_LEGS = 3;   // nonstop, one stop or two stops
+
+    int legCount;
+    int flightIndex[MAX_LEGS];   // indices into the FlightList, in travel order
+    int departureMinute;         // epoch minutes of the first take-off
+    int arrivalMinute;           // epoch minutes of the last landing
+    double fare;                 // sum of the legs' quoted totals
+
+    int getDurationMinutes() const { return arrivalMinute - departureMinute; }
+};
+
+// Route planning over a time-expanded flight graph. Every flight is an edge
+// from its departure event to its arrival event; the departures of each
+// airport are kept sorted by time, so waiting at an airport is a walk along
+// that list and a connection is a binary search into the window between the
+// minimum connection time and the longest allowed layover.
+//
+// A query scans the departures of the requested day and extends each one
+// through the connection windows, pruning every airport from which the
+// destination cannot be reached in the legs that are left. Only the best
+// maxResults itineraries are kept, in a heap whose top is the worst of
+// them; once it is full, a branch that is already slower (or dearer) than
+// that worst one is not extended.
+class ItineraryPlanner {
+public:
+    enum SortOrder { BY_DURATION, BY_FARE };
+
+    static const int DEFAULT_MIN_CONNECTION_MINUTES = 45;
+    static const int DEFAULT_MAX_LAYOVER_MINUTES = 12 * 60;
+
+    ItineraryPlanner();
+    ~ItineraryPlanner();
+
+    void setConnectionWindow(int minConnectionMinutes, int maxLayoverMinutes);
+
+    // Rebuilds the graph from the catalog. Sold-out flights and flights with
+    // unreadable dates or times are left out; fares are quoted here, once.
+    void build(const FlightList& flights, const PricingEngine& pricing);
+
+    // Rebuilds only if the catalog, the pricing tables or the current day
+    // changed since the last build. Returns true when it rebuilt.
+    bool refresh(const FlightList& flights, const PricingEngine& pricing);
+
+    // Itineraries leaving origin on departureDate with at most maxLegs flights,
+    // best first. Returns the number written to results (at most maxResults).
+    int findItineraries(const char* origin, const char* destination, const char* departureDate,
+                        int maxLegs, SortOrder order, int maxResults,
+                        std::vector<Itinerary>& results) const;
+
+    int getConnectionCount() const;
+
+private:
+    // A flight as an edge of the graph
+    struct Connection {
+        int departureMinute;
+        int arrivalMinute;
+        int toAirport;
+        int flightIndex;
+        double fare;
+    };
+
+    // Working state of one query
+    struct Search {
+        int destination;
+        SortOrder order;
+        int maxResults;
+        std::vector<int> legsNeeded;     // fewest flights from each airport to the destination
+        int path[Itinerary::MAX_LEGS + 1];   // airports visited so far, origin first
+        Itinerary partial;
+        std::vector<Itinerary>* found;   // heap of the best so far, worst on top
+    };
+
+    int minConnectionMinutes;
+    int maxLayoverMinutes;
+    int connectionCount;
+
+    // What the graph was built from, for refresh()
+    bool built;
+    int builtCatalogChange;
+    int builtPricingGeneration;
+    int builtDay;
+
+    std::unordered_map<std::string, int> airportIds;
+    std::vector<std::vector<Connection>> departures;   // per airport, sorted by departureMinute
+    std::vector<std::vector<int>> inboundFrom;         // per airport, distinct airports flying in
+
+    int findAirport(const char* code) const;
+    int addAirport(const char* code);
+    void computeLegsNeeded(int destination, int maxLegs, std::vector<int>& legsNeeded) const;
+    void scanDepartures(int airport, int earliest, int latest, int legsLeft, double fareSoFar,
+                        Search& search) const;
+    static bool ranksBefore(const Itinerary& a, const Itinerary& b, SortOrder order);
+    static void keepIfRanked(const Itinerary& itinerary, Search& search);
+};
+
+#endif // ITINERARYPLANNER_H
@@ -0,0 +1,34 @@
+#ifndef JOURNALFILE_H
+#define JOURNALFILE_H
+
+// Append-only file handle for the booking journal. It stays open between
+// records, and sync() forces what was written to disk (fsync, or
+// FlushFileBuffers on Windows), so a record that was reported as written
+// survives a crash. Appends go to the current end of the file; callers
+// hold the storage lock, so other processes never append in between.
+class JournalFile {
+public:
+    JournalFile();
+    ~JournalFile();
+
+    bool open(const char* filename);
+    void close();
+    bool isOpen() const;
+
+    // Writes data at the end of the file; start receives the offset it begins at
+    bool append(const char* data, int length, long long& start);
+    bool truncate();
+    bool sync();
+
+    // Forces a file written through another handle to disk, e.g. a snapshot before it is renamed
+    static bool syncPath(const char* filename);
+
+private:
+#ifdef _WIN32
+    void* fileHandle;
+#else
+    int fd;
+#endif
+};
+
+#endif // JOURNALFILE_H
@@ -0,0 +1,71 @@
+#ifndef JSONSTREAMREADER_H
+#define JSONSTREAMREADER_H
+
+#include <istream>
+#include <vector>
+
+// Single-pass pull tokenizer for the hand-written booking files.
+// Reads the input in large blocks and hands out one token at a time,
+// so memory use is constant no matter how big the file is.
+class JsonStreamReader {
+public:
+    enum TokenType {
+        BEGIN_OBJECT,
+        END_OBJECT,
+        BEGIN_ARRAY,
+        END_ARRAY,
+        KEY,
+        STRING,
+        NUMBER,
+        LITERAL,       // true, false, null
+        END_OF_INPUT,
+        INVALID
+    };
+
+    explicit JsonStreamReader(std::istream& input);
+    JsonStreamReader(const char* data, int length);
+    ~JsonStreamReader();
+
+    // Advance to the next token. Commas and colons are consumed silently.
+    TokenType next();
+
+    // Current token
+    TokenType getType() const;
+    const char* getText() const;
+    bool textEquals(const char* str) const;
+    int getInt() const;
+    double getDouble() const;
+
+    // Skip the value whose first token is the current one (nested containers included)
+    bool skipValue();
+
+private:
+    static const int BLOCK_SIZE = 64 * 1024;
+    static const int MAX_TOKEN_LENGTH = 256;
+    static const int MAX_DEPTH = 32;
+
+    std::istream* input;
+    std::vector<char> block;
+    const char* data;
+    int dataLength;
+    int pos;
+
+    TokenType type;
+    char text[MAX_TOKEN_LENGTH];
+    int textLength;
+
+    // Container stack: true for object, false for array
+    bool inObject[MAX_DEPTH];
+    bool expectKey[MAX_DEPTH];
+    int depth;
+
+    bool fillBlock();
+    int peekChar();
+    int readChar();
+    void appendText(char ch);
+    TokenType readString();
+    TokenType readBareWord();
+    void afterValue();
+};
+
+#endif // JSONSTREAMREADER_H
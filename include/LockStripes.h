@@ -0,0 +1,26 @@
+#ifndef LOCKSTRIPES_H
+#define LOCKSTRIPES_H
+
+#include "FileLock.h"
+#include <memory>
+#include <vector>
+
+// Fixed set of FileLocks, one per hash stripe of flight numbers.
+// Work on different flights usually lands on different stripes and can
+// proceed in parallel; the same flight always maps to the same stripe.
+class LockStripes {
+public:
+    static const int STRIPE_COUNT = 16;
+
+    explicit LockStripes(const char* directory);
+    ~LockStripes();
+
+    FileLock& forFlight(const char* flightNumber);
+    FileLock& forStripe(int stripe);
+    static int stripeFor(const char* flightNumber);
+
+private:
+    std::vector<std::unique_ptr<FileLock>> stripes;
+};
+
+#endif // LOCKSTRIPES_H
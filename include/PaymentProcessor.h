@@ -0,0 +1,45 @@
+#ifndef PAYMENTPROCESSOR_H
+#define PAYMENTPROCESSOR_H
+
+#include <functional>
+#include <future>
+
+struct PaymentRequest {
+    enum Method { CREDIT_CARD = 1, DEBIT_CARD = 2, PAYPAL = 3 };
+
+    double amount;
+    int method;
+    char reference[50];   // shown on the statement, e.g. the passenger name
+};
+
+struct PaymentResult {
+    bool approved;
+    char transactionId[20];
+    char message[60];
+};
+
+typedef std::function<void(const PaymentResult&)> PaymentCallback;
+
+// Asynchronous payment interface. submit() returns at once; the result is
+// delivered later, so any number of payments can be in flight while the
+// caller keeps working.
+class PaymentProcessor {
+public:
+    virtual ~PaymentProcessor();
+
+    // onComplete runs exactly once, on a thread owned by the processor
+    virtual void submit(const PaymentRequest& request, PaymentCallback onComplete) = 0;
+
+    // Gives back an approved payment, e.g. when the seat it paid for was lost.
+    // The result is delivered like submit()'s; approved means the money went back.
+    virtual void refund(const char* transactionId, double amount, PaymentCallback onComplete) = 0;
+
+    // The booking an approved payment was for is committed; it will not be refunded
+    virtual void settle(const char* transactionId) = 0;
+
+    // Future-based forms of submit() and refund()
+    std::future<PaymentResult> submit(const PaymentRequest& request);
+    std::future<PaymentResult> refund(const char* transactionId, double amount);
+};
+
+#endif // PAYMENTPROCESSOR_H
@@ -0,0 +1,39 @@
+#ifndef PNRCODEC_H
+#define PNRCODEC_H
+
+#include <cstdint>
+
+// Reversible mapping between booking IDs and 6-character PNRs.
+// The first character is a letter and the other five are base 36
+// (0-9, A-Z), so a PNR never looks like a numeric booking ID. The ID is
+// scrambled with an affine map x -> (a*x + b) mod SPACE before encoding,
+// which keeps the mapping a bijection while making neighbouring IDs look
+// unrelated. Encoding and decoding are pure arithmetic: no shared state,
+// no locks and no index lookup.
+class PnrCodec {
+public:
+    static const int PNR_LENGTH = 6;
+    static const std::uint64_t SPACE = 26ULL * 36 * 36 * 36 * 36 * 36;   // distinct PNRs
+
+    // Default scrambling constants
+    static const std::uint64_t DEFAULT_MULTIPLIER = 982451653ULL;
+    static const std::uint64_t DEFAULT_OFFSET = 727272727ULL;
+
+    PnrCodec();
+    // multiplier must share no factor with SPACE (2, 3 or 13); 1 and 0 disable scrambling
+    PnrCodec(std::uint64_t multiplier, std::uint64_t offset);
+
+    // pnr needs room for PNR_LENGTH + 1 characters; false if the ID is out of range
+    bool encode(int bookingId, char* pnr) const;
+    // Booking ID for a well-formed PNR (either case), -1 otherwise
+    int decode(const char* pnr) const;
+
+private:
+    std::uint64_t multiplier;
+    std::uint64_t inverse;    // multiplier^-1 mod SPACE
+    std::uint64_t offset;
+
+    static std::uint64_t modularInverse(std::uint64_t value, std::uint64_t modulus);
+};
+
+#endif // PNRCODEC_H
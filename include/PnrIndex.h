@@ -0,0 +1,39 @@
+#ifndef PNRINDEX_H
+#define PNRINDEX_H
+
+#include <cstdint>
+#include <vector>
+
+// Open-addressing (linear probing) hash index from PNR to booking ID.
+// PNRs are packed into a 64-bit key, so a lookup is a few integer
+// compares regardless of how many bookings exist.
+class PnrIndex {
+public:
+    PnrIndex();
+    ~PnrIndex();
+
+    void insert(const char* pnr, int bookingId);
+    void remove(const char* pnr, int bookingId);
+    int find(const char* pnr) const;   // -1 if not found
+
+    void clear();
+    void reserve(int count);
+    int size() const;
+
+private:
+    struct Slot {
+        std::uint64_t key;   // 0 marks an empty slot
+        int bookingId;
+    };
+
+    static const int INITIAL_CAPACITY = 64;
+
+    std::vector<Slot> slots;
+    int count;
+
+    static std::uint64_t packKey(const char* pnr);
+    int homeSlot(std::uint64_t key) const;
+    void rehash(int newCapacity);
+};
+
+#endif // PNRINDEX_H
@@ -0,0 +1,98 @@
+#ifndef PRICINGENGINE_H
+#define PRICINGENGINE_H
+
+#include <atomic>
+#include <vector>
+
+class Flight;
+
+// The AVX2 kernel needs per-function target attributes (GCC/Clang on x86)
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define PRICING_HAVE_AVX2 1
+#endif
+
+// Price of one seat, split the way the pricing breakdown shows it
+struct PriceQuote {
+    double baseFare;
+    double demandSurge;     // from the share of seats already sold
+    double timeSurge;       // from the days left until departure
+    double fare;            // baseFare + both surges
+    double taxes;
+    double total;           // fare + taxes
+};
+
+// Dynamic pricing shared by every screen that shows a price.
+// The surge rules are breakpoint tables read from data/pricing.json and
+// compiled into lookup arrays: one entry per tenth of a percent of
+// occupancy and one per day until departure. A quote is then two array
+// reads and a few multiplications, with no branches on the rules.
+class PricingEngine {
+public:
+    static const int OCCUPANCY_STEPS = 1000;   // occupancy resolution: 0.1%
+
+    PricingEngine();   // starts with the built-in tables
+    ~PricingEngine();
+
+    // Replaces the tables; on a missing or invalid file the current ones stay
+    bool loadFromFile(const char* filename);
+
+    PriceQuote quote(const Flight& flight, int daysUntilDeparture) const;
+    PriceQuote quote(double basePrice, int totalSeats, int availableSeats, int daysUntilDeparture) const;
+
+    // Batch form for search results and fare calendars: one column per input,
+    // totals (fare + taxes) written to fares. Uses AVX2 when the CPU has it;
+    // the result is identical to quote() either way.
+    void quoteFares(const double* basePrices, const int* totalSeats, const int* availableSeats,
+                    const int* daysUntilDeparture, int count, double* fares) const;
+    static bool usesAvx2();
+
+    double getTaxes() const { return taxes; }
+
+    // Quote caching (see Flight::getPriceQuote). A quote stays valid while the
+    // tables keep their generation and the flight stays in the same buckets.
+    int getGeneration() const { return generation; }
+    int timeBucket(int daysUntilDeparture) const;
+    // Available-seat counts that share the demand surge of availableSeats
+    void demandRange(int totalSeats, int availableSeats, int& minAvailable, int& maxAvailable) const;
+
+private:
+    // Breakpoint rules as written in the config file
+    struct DemandRule {
+        double minOccupancy;   // applies at or above this share of seats sold
+        double surge;          // fraction of the base fare
+    };
+    struct TimeRule {
+        int maxDays;           // applies at or below this many days out
+        double surge;
+    };
+
+    double taxes;
+    std::vector<double> demandByStep;   // OCCUPANCY_STEPS + 1 entries
+    std::vector<double> timeByDay;      // last entry covers every later day
+
+    // Breakpoint boundaries: first and last step of the run with the same surge,
+    // and a bucket number per day that changes only where the surge does
+    std::vector<int> demandRunStart;
+    std::vector<int> demandRunEnd;
+    std::vector<int> timeBucketByDay;
+
+    // Unique per compiled table set, so caches never outlive a config reload
+    int generation;
+    static std::atomic<int> nextGeneration;
+
+    void compile(std::vector<DemandRule> demandRules, std::vector<TimeRule> timeRules);
+
+    int occupancyStep(int totalSeats, int availableSeats) const;
+    double demandRate(int totalSeats, int availableSeats) const;
+    double timeRate(int daysUntilDeparture) const;
+
+    void quoteFaresScalar(const double* basePrices, const int* totalSeats, const int* availableSeats,
+                          const int* daysUntilDeparture, int count, double* fares) const;
+#ifdef PRICING_HAVE_AVX2
+    __attribute__((target("avx2")))
+    void quoteFaresAvx2(const double* basePrices, const int* totalSeats, const int* availableSeats,
+                        const int* daysUntilDeparture, int count, double* fares) const;
+#endif
+};
+
+#endif // PRICINGENGINE_H
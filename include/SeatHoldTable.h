@@ -0,0 +1,52 @@
+#ifndef SEATHOLDTABLE_H
+#define SEATHOLDTABLE_H
+
+#include "TimerWheel.h"
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct SeatHold {
+    std::uint64_t holdId;
+    char flightNumber[10];
+    char seatNumber[5];
+    long long expiresAt;   // seconds since the epoch
+};
+
+// Temporary seat reservations with a time-to-live. Holds are found by id
+// or by seat in O(1) and expire through a timer wheel that the caller
+// advances with the current time; a hold past its expiry never counts,
+// even before the wheel has reached it.
+class SeatHoldTable {
+public:
+    SeatHoldTable();
+    ~SeatHoldTable();
+
+    // Places or extends a hold. False if another live hold has the seat.
+    bool place(std::uint64_t holdId, const char* flightNumber, const char* seatNumber,
+               long long expiresAt, long long now);
+    void release(std::uint64_t holdId);
+    void releaseSeat(const char* flightNumber, const char* seatNumber);
+
+    // Live holds only (nullptr / 0 when absent or expired)
+    const SeatHold* find(std::uint64_t holdId, long long now) const;
+    std::uint64_t holderOf(const char* flightNumber, int row, int column, long long now) const;
+
+    // Drops every hold that has expired by now
+    void expire(long long now);
+    void collectLive(std::vector<SeatHold>& out, long long now) const;
+    void clear();
+    int size() const { return static_cast<int>(holds.size()); }
+
+private:
+    std::unordered_map<std::uint64_t, SeatHold> holds;
+    std::unordered_map<std::string, std::uint64_t> holdBySeat;
+    TimerWheel expiries;
+    std::vector<TimerWheel::Timer> expired;
+
+    void erase(std::unordered_map<std::uint64_t, SeatHold>::iterator it);
+    static std::string seatKey(const char* flightNumber, int row, int column);
+};
+
+#endif // SEATHOLDTABLE_H
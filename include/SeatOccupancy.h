@@ -0,0 +1,50 @@
+#ifndef SEATOCCUPANCY_H
+#define SEATOCCUPANCY_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+// Occupied-seat bitmap for every flight, one bit per (row, column).
+// A seat check is a single bit test and the occupied count is a popcount,
+// so neither depends on how many bookings exist overall.
+class SeatOccupancy {
+public:
+    static const int MAX_ROWS = 99;
+    static const int SEATS_PER_ROW = 6;   // A-F
+    static const int SEAT_BITS = MAX_ROWS * SEATS_PER_ROW;
+    static const int WORD_COUNT = (SEAT_BITS + 63) / 64;
+
+    SeatOccupancy();
+    ~SeatOccupancy();
+
+    // Seat strings look like "12A"; returns false for anything else
+    static bool parseSeat(const char* seatNumber, int& row, int& column);
+
+    void occupy(const char* flightNumber, const char* seatNumber);
+    void release(const char* flightNumber, const char* seatNumber);
+    bool isOccupied(const char* flightNumber, const char* seatNumber) const;
+    bool isOccupied(const char* flightNumber, int row, int column) const;
+    int getOccupiedCount(const char* flightNumber) const;
+
+    // Copies the flight's WORD_COUNT bitmap words (all zero for an unknown flight)
+    void copyWords(const char* flightNumber, std::uint64_t* words) const;
+
+    void clear();
+
+private:
+    struct FlightSeats {
+        std::uint64_t words[WORD_COUNT];
+    };
+
+    std::unordered_map<std::string, FlightSeats> flights;
+
+    // Extra holders of an already-set bit (duplicate seats in old data),
+    // so releasing one of them does not free the seat for the others
+    std::unordered_map<std::string, int> duplicateHolders;
+
+    const FlightSeats* findFlight(const char* flightNumber) const;
+    static std::string duplicateKey(const char* flightNumber, int bit);
+};
+
+#endif // SEATOCCUPANCY_H
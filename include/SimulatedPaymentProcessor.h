@@ -0,0 +1,75 @@
+#ifndef SIMULATEDPAYMENTPROCESSOR_H
+#define SIMULATEDPAYMENTPROCESSOR_H
+
+#include "PaymentProcessor.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <queue>
+#include <random>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Local stand-in for a payment gateway. Each payment completes after the
+// configured latency and is declined with the configured probability.
+// A single timer thread sleeps until the earliest deadline, so thousands
+// of payments can be pending without a thread each.
+// An approved payment stays refundable until it is settled or its refund
+// window runs out, so the processor's memory is bounded by the payments
+// of the last window rather than growing with every payment ever made.
+class SimulatedPaymentProcessor : public PaymentProcessor {
+public:
+    static const int REFUND_WINDOW_MINUTES = 60;
+
+    SimulatedPaymentProcessor(int latencyMs, double failureRate);
+    ~SimulatedPaymentProcessor() override;
+
+    using PaymentProcessor::submit;
+    using PaymentProcessor::refund;
+    void submit(const PaymentRequest& request, PaymentCallback onComplete) override;
+    void refund(const char* transactionId, double amount, PaymentCallback onComplete) override;
+    void settle(const char* transactionId) override;
+
+    void setLatency(int latencyMs);
+    void setFailureRate(double failureRate);
+    int getInFlightCount();
+    int getRefundableCount();
+
+private:
+    struct ScheduledPayment {
+        std::chrono::steady_clock::time_point due;
+        std::uint64_t sequence;   // keeps payments with equal deadlines in order
+        PaymentResult result;
+        PaymentCallback onComplete;
+    };
+    struct LaterFirst {
+        bool operator()(const ScheduledPayment& a, const ScheduledPayment& b) const {
+            return a.due != b.due ? a.due > b.due : a.sequence > b.sequence;
+        }
+    };
+
+    std::mutex stateMutex;
+    std::condition_variable changed;
+    std::priority_queue<ScheduledPayment, std::vector<ScheduledPayment>, LaterFirst> pending;
+    std::unordered_map<std::string, double> refundable;   // approved amount left per transaction ID
+    std::deque<std::pair<std::chrono::steady_clock::time_point, std::string>> refundDeadlines;   // oldest first
+    bool stopping;
+    std::uint64_t nextSequence;
+    std::uint64_t nextTransactionNumber;
+    std::mt19937 random;
+    int latencyMs;
+    double failureRate;
+    std::thread timerThread;
+
+    void schedule(ScheduledPayment& payment);
+    void expireRefundable(std::chrono::steady_clock::time_point now);
+    static void rejectWhileStopping(ScheduledPayment& payment);
+    void timerLoop();
+};
+
+#endif // SIMULATEDPAYMENTPROCESSOR_H
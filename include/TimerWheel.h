@@ -0,0 +1,50 @@
+#ifndef TIMERWHEEL_H
+#define TIMERWHEEL_H
+
+#include <cstdint>
+#include <vector>
+
+// Hierarchical timer wheel: LEVELS wheels of SLOTS slots, each level
+// SLOTS times coarser than the one below. Scheduling is O(1); a timer
+// cascades down one level at a time as its expiry comes closer. The
+// wheel has no clock of its own and is advanced lazily to whatever tick
+// the caller passes, skipping stretches in which nothing can fire.
+// Cancelled timers are not removed; callers ignore stale ids when they fire.
+class TimerWheel {
+public:
+    static const int SLOT_BITS = 6;
+    static const int SLOTS = 1 << SLOT_BITS;   // 64
+    static const int LEVELS = 4;                // 64^4 ticks, about 194 days of seconds
+
+    struct Timer {
+        std::uint64_t id;
+        long long expiryTick;
+    };
+
+    explicit TimerWheel(long long startTick = 0);
+    ~TimerWheel();
+
+    void schedule(std::uint64_t id, long long expiryTick);
+
+    // Moves the wheel to nowTick and appends every timer due by then
+    void advance(long long nowTick, std::vector<Timer>& expired);
+
+    // Drops every timer; the current tick is kept
+    void clear();
+
+    long long getCurrentTick() const { return currentTick; }
+    int size() const { return count; }
+
+private:
+    long long currentTick;
+    int count;
+    int levelCounts[LEVELS];
+    std::vector<Timer> slots[LEVELS][SLOTS];
+    std::vector<Timer> overdue;   // scheduled at or before the current tick
+
+    void place(const Timer& timer);
+    void cascade(int level);
+    void step(std::vector<Timer>& expired);
+};
+
+#endif // TIMERWHEEL_H
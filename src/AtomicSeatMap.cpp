@@ -0,0 +1,81 @@
+#include "AtomicSeatMap.h"
+#include <bit>
+#include <mutex>
+
+AtomicSeatMap::AtomicSeatMap() {}
+
+AtomicSeatMap::~AtomicSeatMap() {}
+
+void AtomicSeatMap::addFlight(const char* flightNumber, const std::uint64_t* seedWords) {
+    std::unique_lock<std::shared_mutex> guard(tableMutex);
+    std::unique_ptr<FlightSeats>& seats = flights[flightNumber];
+    if (seats) return;
+
+    seats.reset(new FlightSeats);
+    for (int i = 0; i < SeatOccupancy::WORD_COUNT; i++) {
+        seats->words[i].store(seedWords ? seedWords[i] : 0, std::memory_order_relaxed);
+    }
+}
+
+bool AtomicSeatMap::hasFlight(const char* flightNumber) const {
+    return findFlight(flightNumber) != nullptr;
+}
+
+bool AtomicSeatMap::tryClaim(const char* flightNumber, const char* seatNumber) {
+    int word;
+    std::uint64_t mask;
+    FlightSeats* seats = findFlight(flightNumber);
+    if (!seats || !seatBit(seatNumber, word, mask)) return false;
+
+    std::atomic<std::uint64_t>& bits = seats->words[word];
+    std::uint64_t current = bits.load(std::memory_order_acquire);
+    do {
+        if (current & mask) return false;   // another thread got there first
+    } while (!bits.compare_exchange_weak(current, current | mask,
+                                         std::memory_order_acq_rel, std::memory_order_acquire));
+    return true;
+}
+
+void AtomicSeatMap::release(const char* flightNumber, const char* seatNumber) {
+    int word;
+    std::uint64_t mask;
+    FlightSeats* seats = findFlight(flightNumber);
+    if (!seats || !seatBit(seatNumber, word, mask)) return;
+    seats->words[word].fetch_and(~mask, std::memory_order_acq_rel);
+}
+
+bool AtomicSeatMap::isClaimed(const char* flightNumber, const char* seatNumber) const {
+    int word;
+    std::uint64_t mask;
+    FlightSeats* seats = findFlight(flightNumber);
+    if (!seats || !seatBit(seatNumber, word, mask)) return false;
+    return (seats->words[word].load(std::memory_order_acquire) & mask) != 0;
+}
+
+int AtomicSeatMap::getClaimedCount(const char* flightNumber) const {
+    FlightSeats* seats = findFlight(flightNumber);
+    if (!seats) return 0;
+
+    int count = 0;
+    for (int i = 0; i < SeatOccupancy::WORD_COUNT; i++) {
+        count += std::popcount(seats->words[i].load(std::memory_order_acquire));
+    }
+    return count;
+}
+
+AtomicSeatMap::FlightSeats* AtomicSeatMap::findFlight(const char* flightNumber) const {
+    std::shared_lock<std::shared_mutex> guard(tableMutex);
+    auto it = flights.find(flightNumber);
+    // Entries are never removed, so the pointer stays valid after unlocking
+    return it != flights.end() ? it->second.get() : nullptr;
+}
+
+bool AtomicSeatMap::seatBit(const char* seatNumber, int& word, std::uint64_t& mask) {
+    int row, column;
+    if (!SeatOccupancy::parseSeat(seatNumber, row, column)) return false;
+
+    int bit = (row - 1) * SeatOccupancy::SEATS_PER_ROW + column;
+    word = bit >> 6;
+    mask = std::uint64_t(1) << (bit & 63);
+    return true;
+}
@@ -0,0 +1,432 @@
+#include "BinaryBookingStore.h"
+#include "StringUtils.h"
+#include <cstddef>
+#include <cstring>
+#include <iostream>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static const char STORE_MAGIC[8] = {'A', 'B', 'K', 'S', 'T', 'O', 'R', 'E'};
+static const std::uint32_t STORE_FORMAT_VERSION = 2;
+
+// Version 1 had a 64-byte header and no change log
+static const std::uint32_t STORE_FORMAT_VERSION_1 = 1;
+static const std::size_t VERSION_1_HEADER_SIZE = 64;
+static_assert(offsetof(BookingStoreHeader, changedSlots) == VERSION_1_HEADER_SIZE,
+              "the version 1 header fields must keep their offsets");
+
+BinaryBookingStore::BinaryBookingStore()
+#ifdef _WIN32
+    : fileHandle(INVALID_HANDLE_VALUE), mappingHandle(nullptr),
+#else
+    : fd(-1),
+#endif
+      base(nullptr), mappedSize(0), indexedCount(0) {}
+
+BinaryBookingStore::~BinaryBookingStore() {
+    close();
+}
+
+bool BinaryBookingStore::open(const char* filename) {
+    close();
+    if (!openFile(filename, false)) {
+        std::cout << "Error: Cannot open booking store: " << filename << std::endl;
+        return false;
+    }
+
+    std::size_t size = fileSize();
+    if (size == 0) {
+        return initializeHeader();
+    }
+    if (size < sizeof(BookingStoreHeader) || !mapFile(size)) {
+        std::cout << "Error: Booking store is corrupt: " << filename << std::endl;
+        close();
+        return false;
+    }
+
+    BookingStoreHeader* h = header();
+    if (std::memcmp(h->magic, STORE_MAGIC, sizeof(STORE_MAGIC)) == 0 &&
+        h->formatVersion == STORE_FORMAT_VERSION_1 && h->recordSize == sizeof(BookingRecord)) {
+        if (!upgradeFromVersion1(size)) {
+            std::cout << "Error: Cannot upgrade booking store: " << filename << std::endl;
+            close();
+            return false;
+        }
+        h = header();
+        size = fileSizeFor(h->capacity);
+    }
+    if (std::memcmp(h->magic, STORE_MAGIC, sizeof(STORE_MAGIC)) != 0 ||
+        h->formatVersion != STORE_FORMAT_VERSION ||
+        h->recordSize != sizeof(BookingRecord) ||
+        fileSizeFor(h->capacity) > size) {
+        std::cout << "Error: Unsupported booking store format: " << filename << std::endl;
+        close();
+        return false;
+    }
+
+    indexNewRecords();
+    return true;
+}
+
+bool BinaryBookingStore::create(const char* filename) {
+    close();
+    if (!openFile(filename, true)) {
+        std::cout << "Error: Cannot create booking store: " << filename << std::endl;
+        return false;
+    }
+    return initializeHeader();
+}
+
+bool BinaryBookingStore::initializeHeader() {
+    if (!resizeFile(fileSizeFor(INITIAL_CAPACITY)) || !mapFile(fileSizeFor(INITIAL_CAPACITY))) {
+        close();
+        return false;
+    }
+
+    BookingStoreHeader* h = header();
+    std::memset(h, 0, sizeof(BookingStoreHeader));
+    std::memcpy(h->magic, STORE_MAGIC, sizeof(STORE_MAGIC));
+    h->formatVersion = STORE_FORMAT_VERSION;
+    h->recordSize = sizeof(BookingRecord);
+    h->recordCount = 0;
+    h->capacity = INITIAL_CAPACITY;
+    h->nextBookingId = 1000;
+    h->changeCount = 0;
+    return true;
+}
+
+bool BinaryBookingStore::upgradeFromVersion1(std::size_t size) {
+    // The records move up to make room for the change log
+    int recordCount = header()->recordCount;
+    int capacity = header()->capacity;
+    if (recordCount < 0 || recordCount > capacity ||
+        VERSION_1_HEADER_SIZE + static_cast<std::size_t>(capacity) * sizeof(BookingRecord) > size) {
+        return false;
+    }
+
+    unmapFile();
+    if (!resizeFile(fileSizeFor(capacity)) || !mapFile(fileSizeFor(capacity))) {
+        return false;
+    }
+    std::memmove(base + sizeof(BookingStoreHeader), base + VERSION_1_HEADER_SIZE,
+                 static_cast<std::size_t>(recordCount) * sizeof(BookingRecord));
+
+    BookingStoreHeader* h = header();
+    std::memset(reinterpret_cast<char*>(h) + VERSION_1_HEADER_SIZE, 0,
+                sizeof(BookingStoreHeader) - VERSION_1_HEADER_SIZE);
+    h->reserved0 = 0;
+    h->changeCount = 0;
+    std::memset(h->reserved, 0, sizeof(h->reserved));
+    h->formatVersion = STORE_FORMAT_VERSION;
+    return sync();
+}
+
+void BinaryBookingStore::close() {
+    unmapFile();
+#ifdef _WIN32
+    if (fileHandle != INVALID_HANDLE_VALUE) {
+        CloseHandle(fileHandle);
+        fileHandle = INVALID_HANDLE_VALUE;
+    }
+#else
+    if (fd >= 0) {
+        ::close(fd);
+        fd = -1;
+    }
+#endif
+    slotById.clear();
+    indexedCount = 0;
+}
+
+bool BinaryBookingStore::isOpen() const {
+    return base != nullptr;
+}
+
+bool BinaryBookingStore::sync() {
+    if (!base) return false;
+#ifdef _WIN32
+    return FlushViewOfFile(base, mappedSize) != 0;
+#else
+    return msync(base, mappedSize, MS_SYNC) == 0;
+#endif
+}
+
+int BinaryBookingStore::getRecordCount() {
+    if (!refreshMapping()) return 0;
+    return header()->recordCount;
+}
+
+bool BinaryBookingStore::readRecord(int slot, Booking& booking) {
+    if (!refreshMapping() || slot < 0 || slot >= header()->recordCount) return false;
+
+    const BookingRecord* rec = record(slot);
+    if (rec->flags != RECORD_LIVE) return false;
+    fromRecord(*rec, booking);
+    return true;
+}
+
+bool BinaryBookingStore::storeBooking(const Booking& booking) {
+    if (!refreshMapping()) return false;
+
+    int slot;
+    auto it = slotById.find(booking.getBookingId());
+    if (it != slotById.end()) {
+        slot = it->second;
+    } else {
+        slot = header()->recordCount;
+        if (!ensureCapacity(slot + 1)) return false;
+        std::memset(record(slot), 0, sizeof(BookingRecord));
+        header()->recordCount = slot + 1;
+        slotById[booking.getBookingId()] = slot;
+        indexedCount = slot + 1;
+    }
+
+    // In-place write of a single record
+    BookingRecord* rec = record(slot);
+    std::uint32_t version = rec->version + 1;
+    toRecord(booking, *rec);
+    rec->version = version;
+    rec->flags = RECORD_LIVE;
+    logChange(slot);
+    return true;
+}
+
+bool BinaryBookingStore::removeBooking(int bookingId) {
+    if (!refreshMapping()) return false;
+
+    auto it = slotById.find(bookingId);
+    if (it == slotById.end()) return false;
+
+    BookingRecord* rec = record(it->second);
+    rec->flags = RECORD_CANCELLED;
+    rec->version++;
+    logChange(it->second);
+    slotById.erase(it);
+    return true;
+}
+
+int BinaryBookingStore::getNextBookingId() {
+    if (!refreshMapping()) return 1000;
+    return header()->nextBookingId;
+}
+
+void BinaryBookingStore::setNextBookingId(int id) {
+    if (refreshMapping() && id > header()->nextBookingId) {
+        header()->nextBookingId = id;
+    }
+}
+
+std::uint64_t BinaryBookingStore::getChangeCount() {
+    if (!refreshMapping()) return 0;
+    return header()->changeCount;
+}
+
+bool BinaryBookingStore::getChangedSlots(std::uint64_t since, std::vector<int>& slots) {
+    slots.clear();
+    if (!refreshMapping()) return false;
+
+    const BookingStoreHeader* h = header();
+    std::uint64_t current = h->changeCount;
+    if (since > current || current - since > static_cast<std::uint64_t>(BOOKING_STORE_CHANGE_LOG_SIZE)) {
+        return false;
+    }
+    for (std::uint64_t change = since; change < current; change++) {
+        slots.push_back(h->changedSlots[change % BOOKING_STORE_CHANGE_LOG_SIZE]);
+    }
+    return true;
+}
+
+int BinaryBookingStore::getRecordBookingId(int slot) {
+    if (!refreshMapping() || slot < 0 || slot >= header()->recordCount) return -1;
+    return record(slot)->bookingId;
+}
+
+// Private helpers
+BookingStoreHeader* BinaryBookingStore::header() {
+    return reinterpret_cast<BookingStoreHeader*>(base);
+}
+
+BookingRecord* BinaryBookingStore::record(int slot) {
+    return reinterpret_cast<BookingRecord*>(base + sizeof(BookingStoreHeader)) + slot;
+}
+
+void BinaryBookingStore::logChange(int slot) {
+    // The slot goes in before the count moves past it
+    BookingStoreHeader* h = header();
+    h->changedSlots[h->changeCount % BOOKING_STORE_CHANGE_LOG_SIZE] = slot;
+    h->changeCount++;
+}
+
+std::size_t BinaryBookingStore::fileSizeFor(int capacity) {
+    return sizeof(BookingStoreHeader) + static_cast<std::size_t>(capacity) * sizeof(BookingRecord);
+}
+
+bool BinaryBookingStore::ensureCapacity(int slots) {
+    int capacity = header()->capacity;
+    if (slots <= capacity) return true;
+
+    int newCapacity = capacity * 2;
+    if (newCapacity < slots) newCapacity = slots;
+
+    // The view must be unmapped before the file can be resized on Windows
+    unmapFile();
+    if (!resizeFile(fileSizeFor(newCapacity)) || !mapFile(fileSizeFor(newCapacity))) {
+        std::cout << "Error: Cannot grow booking store." << std::endl;
+        return false;
+    }
+    header()->capacity = newCapacity;
+    return true;
+}
+
+bool BinaryBookingStore::refreshMapping() {
+    if (!base) return false;
+
+    // Another process may have grown the file since it was mapped
+    std::size_t required = fileSizeFor(header()->capacity);
+    if (required > mappedSize) {
+        unmapFile();
+        if (!mapFile(required)) return false;
+    }
+    indexNewRecords();
+    return true;
+}
+
+void BinaryBookingStore::indexNewRecords() {
+    int count = header()->recordCount;
+    for (int slot = indexedCount; slot < count; slot++) {
+        const BookingRecord* rec = record(slot);
+        if (rec->flags == RECORD_LIVE) {
+            slotById[rec->bookingId] = slot;
+        }
+    }
+    if (count > indexedCount) indexedCount = count;
+}
+
+void BinaryBookingStore::toRecord(const Booking& booking, BookingRecord& rec) {
+    rec.bookingId = booking.getBookingId();
+    rec.totalPrice = booking.getTotalPrice();
+    copyString(rec.pnr, booking.getPnr(), sizeof(rec.pnr));
+    copyString(rec.passengerName, booking.getPassengerName(), sizeof(rec.passengerName));
+    copyString(rec.flightNumber, booking.getFlightNumber(), sizeof(rec.flightNumber));
+    copyString(rec.origin, booking.getOrigin(), sizeof(rec.origin));
+    copyString(rec.destination, booking.getDestination(), sizeof(rec.destination));
+    copyString(rec.departureDate, booking.getDepartureDate(), sizeof(rec.departureDate));
+    copyString(rec.departureTime, booking.getDepartureTime(), sizeof(rec.departureTime));
+    copyString(rec.seatNumber, booking.getSeatNumber(), sizeof(rec.seatNumber));
+    copyString(rec.cabinClass, booking.getCabinClass(), sizeof(rec.cabinClass));
+    copyString(rec.bookingStatus, booking.getBookingStatus(), sizeof(rec.bookingStatus));
+    copyString(rec.bookingDate, booking.getBookingDate(), sizeof(rec.bookingDate));
+    copyString(rec.bookingTime, booking.getBookingTime(), sizeof(rec.bookingTime));
+}
+
+void BinaryBookingStore::fromRecord(const BookingRecord& rec, Booking& booking) {
+    booking.setBookingId(rec.bookingId);
+    booking.setTotalPrice(rec.totalPrice);
+    booking.setPnr(rec.pnr);
+    booking.setPassengerName(rec.passengerName);
+    booking.setFlightNumber(rec.flightNumber);
+    booking.setOrigin(rec.origin);
+    booking.setDestination(rec.destination);
+    booking.setDepartureDate(rec.departureDate);
+    booking.setDepartureTime(rec.departureTime);
+    booking.setSeatNumber(rec.seatNumber);
+    booking.setCabinClass(rec.cabinClass);
+    booking.setBookingStatus(rec.bookingStatus);
+    booking.setBookingDate(rec.bookingDate);
+    booking.setBookingTime(rec.bookingTime);
+}
+
+// Platform-specific file mapping
+#ifdef _WIN32
+bool BinaryBookingStore::openFile(const char* filename, bool truncate) {
+    fileHandle = CreateFileA(filename, GENERIC_READ | GENERIC_WRITE,
+                             FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr,
+                             truncate ? CREATE_ALWAYS : OPEN_ALWAYS,
+                             FILE_ATTRIBUTE_NORMAL, nullptr);
+    return fileHandle != INVALID_HANDLE_VALUE;
+}
+
+std::size_t BinaryBookingStore::fileSize() {
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(fileHandle, &size)) return 0;
+    return static_cast<std::size_t>(size.QuadPart);
+}
+
+bool BinaryBookingStore::resizeFile(std::size_t size) {
+    LARGE_INTEGER target;
+    target.QuadPart = static_cast<LONGLONG>(size);
+    return SetFilePointerEx(fileHandle, target, nullptr, FILE_BEGIN) && SetEndOfFile(fileHandle);
+}
+
+bool BinaryBookingStore::mapFile(std::size_t size) {
+    ULARGE_INTEGER mapSize;
+    mapSize.QuadPart = size;
+    mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READWRITE,
+                                       mapSize.HighPart, mapSize.LowPart, nullptr);
+    if (!mappingHandle) return false;
+
+    base = static_cast<char*>(MapViewOfFile(mappingHandle, FILE_MAP_ALL_ACCESS, 0, 0, size));
+    if (!base) {
+        CloseHandle(mappingHandle);
+        mappingHandle = nullptr;
+        return false;
+    }
+    mappedSize = size;
+    return true;
+}
+
+void BinaryBookingStore::unmapFile() {
+    if (base) {
+        FlushViewOfFile(base, mappedSize);
+        UnmapViewOfFile(base);
+        base = nullptr;
+    }
+    if (mappingHandle) {
+        CloseHandle(mappingHandle);
+        mappingHandle = nullptr;
+    }
+    mappedSize = 0;
+}
+#else
+bool BinaryBookingStore::openFile(const char* filename, bool truncate) {
+    int flags = O_RDWR | O_CREAT;
+    if (truncate) flags |= O_TRUNC;
+    fd = ::open(filename, flags, 0644);
+    return fd >= 0;
+}
+
+std::size_t BinaryBookingStore::fileSize() {
+    struct stat st;
+    if (fstat(fd, &st) != 0) return 0;
+    return static_cast<std::size_t>(st.st_size);
+}
+
+bool BinaryBookingStore::resizeFile(std::size_t size) {
+    return ftruncate(fd, static_cast<off_t>(size)) == 0;
+}
+
+bool BinaryBookingStore::mapFile(std::size_t size) {
+    void* addr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (addr == MAP_FAILED) return false;
+    base = static_cast<char*>(addr);
+    mappedSize = size;
+    return true;
+}
+
+void BinaryBookingStore::unmapFile() {
+    if (base) {
+        munmap(base, mappedSize);
+        base = nullptr;
+    }
+    mappedSize = 0;
+}
+#endif
@@ -1,5 +1,6 @@
 #include "Booking.h"
 #include "StringUtils.h"
+#include "Date.h"
 #include <iostream>
 
 Booking::Booking() {
@@ -10,6 +11,7 @@ Booking::Booking() {
     origin[0] = '\0';
     destination[0] = '\0';
     departureDate[0] = '\0';
+    departureDay = Date::INVALID_DAY;
     departureTime[0] = '\0';
     seatNumber[0] = '\0';
     cabinClass[0] = '\0';
@@ -71,7 +73,10 @@ void Booking::setPassengerName(const char* name) { copyString(passengerName, nam
 void Booking::setFlightNumber(const char* flightNum) { copyString(flightNumber, flightNum, 10); }
 void Booking::setOrigin(const char* orig) { copyString(origin, orig, 10); }
 void Booking::setDestination(const char* dest) { copyString(destination, dest, 10); }
-void Booking::setDepartureDate(const char* date) { copyString(departureDate, date, 15); }
+void Booking::setDepartureDate(const char* date) {
+    copyString(departureDate, date, 15);
+    departureDay = Date::parse(departureDate);
+}
 void Booking::setDepartureTime(const char* time) { copyString(departureTime, time, 10); }
 void Booking::setSeatNumber(const char* seat) { copyString(seatNumber, seat, 5); }
 void Booking::setCabinClass(const char* cabin) { copyString(cabinClass, cabin, 15); }
@@ -87,6 +92,7 @@ const char* Booking::getFlightNumber() const { return flightNumber; }
 const char* Booking::getOrigin() const { return origin; }
 const char* Booking::getDestination() const { return destination; }
 const char* Booking::getDepartureDate() const { return departureDate; }
+int Booking::getDepartureDay() const { return departureDay; }
 const char* Booking::getDepartureTime() const { return departureTime; }
 const char* Booking::getSeatNumber() const { return seatNumber; }
 const char* Booking::getCabinClass() const { return cabinClass; }
@@ -0,0 +1,288 @@
+#include "BookingEngine.h"
+#include "StringUtils.h"
+#include <algorithm>
+#include <iostream>
+
+BookingEngine::BookingEngine(BookingManager& bookingManager, FlightList& flightList,
+                             FileLock& globalLock, LockStripes& flightLocks, int workerCount,
+                             PaymentProcessor* paymentProcessor)
+    : bookingManager(bookingManager), flightList(flightList), globalLock(globalLock),
+      flightLocks(flightLocks), paymentProcessor(paymentProcessor), stopping(false),
+      paymentsInFlight(0), refundsInFlight(0), submitted(0), booked(0), failed(0),
+      lastCompletionMicros(0) {
+    if (workerCount < 1) workerCount = 1;
+    workers.reserve(workerCount);
+    for (int i = 0; i < workerCount; i++) {
+        workers.emplace_back(&BookingEngine::workerLoop, this);
+    }
+}
+
+BookingEngine::~BookingEngine() {
+    shutdown();
+}
+
+std::future<BookingResult> BookingEngine::submit(const BookingRequest& request) {
+    std::unique_ptr<PendingBooking> pending(new PendingBooking);
+    pending->request = request;
+    pending->paid = false;
+    std::future<BookingResult> future = pending->result.get_future();
+
+    {
+        std::lock_guard<std::mutex> guard(queueMutex);
+        if (stopping) {
+            pending->result.set_value(BookingResult{BookingResult::FAILED, -1});
+            return future;
+        }
+        if (submitted.load() == 0) {
+            firstSubmit = std::chrono::steady_clock::now();
+        }
+        submitted++;
+        queue.push_back(std::move(pending));
+    }
+    queueReady.notify_one();
+    return future;
+}
+
+void BookingEngine::shutdown() {
+    {
+        std::lock_guard<std::mutex> guard(queueMutex);
+        stopping = true;
+    }
+    queueReady.notify_all();
+    for (std::thread& worker : workers) {
+        if (worker.joinable()) worker.join();
+    }
+}
+
+double BookingEngine::getBookingsPerSecond() const {
+    long long micros = lastCompletionMicros.load();
+    if (micros <= 0) return 0.0;
+    return booked.load() * 1000000.0 / micros;
+}
+
+int BookingEngine::defaultWorkerCount() {
+    // Commits are serialized by the global lock, so more workers only help the claim step
+    int cores = static_cast<int>(std::thread::hardware_concurrency());
+    if (cores < 1) return 1;
+    return cores < 8 ? cores : 8;
+}
+
+void BookingEngine::workerLoop() {
+    std::vector<std::unique_ptr<PendingBooking>> batch;
+    batch.reserve(MAX_BATCH);
+    while (true) {
+        {
+            // Paid requests come back through the queue, so stay up until none are out
+            std::unique_lock<std::mutex> guard(queueMutex);
+            queueReady.wait(guard, [this] {
+                return !queue.empty() || (stopping && paymentsInFlight == 0 && refundsInFlight == 0);
+            });
+            if (queue.empty()) return;   // stopping and drained
+
+            while (!queue.empty() && static_cast<int>(batch.size()) < MAX_BATCH) {
+                batch.push_back(std::move(queue.front()));
+                queue.pop_front();
+            }
+        }
+        processBatch(batch);
+        batch.clear();
+    }
+}
+
+void BookingEngine::processBatch(std::vector<std::unique_ptr<PendingBooking>>& batch) {
+    // Claim step: a seat already claimed in this process fails at once
+    std::vector<PendingBooking*> claimed;
+    for (std::unique_ptr<PendingBooking>& pending : batch) {
+        const BookingRequest& request = pending->request;
+        if (pending->paid) {
+            // Back from the payment processor; the seat is still claimed
+            if (pending->payment.approved) {
+                claimed.push_back(pending.get());
+            } else {
+                seatClaims.release(request.flightNumber, request.seatNumber);
+                complete(*pending, BookingResult{BookingResult::PAYMENT_DECLINED, -1});
+            }
+        } else if (!prepareFlight(request.flightNumber)) {
+            complete(*pending, BookingResult{BookingResult::FLIGHT_NOT_FOUND, -1});
+        } else if (!seatClaims.tryClaim(request.flightNumber, request.seatNumber)) {
+            complete(*pending, BookingResult{BookingResult::SEAT_TAKEN, -1});
+        } else if (paymentProcessor) {
+            submitPayment(std::move(pending));
+        } else {
+            claimed.push_back(pending.get());
+        }
+    }
+    if (claimed.empty()) return;
+
+    std::vector<BookingResult> results(claimed.size(), BookingResult{BookingResult::FAILED, -1});
+    commitBatch(claimed, results);
+
+    for (size_t i = 0; i < claimed.size(); i++) {
+        // Keep the claim only if the seat really is occupied now
+        if (results[i].status != BookingResult::BOOKED && results[i].status != BookingResult::SEAT_TAKEN) {
+            seatClaims.release(claimed[i]->request.flightNumber, claimed[i]->request.seatNumber);
+        }
+        // Only approved payments reach the commit step: a booked one is settled,
+        // any other was charged for nothing and is refunded
+        if (claimed[i]->paid) {
+            if (results[i].status == BookingResult::BOOKED) {
+                paymentProcessor->settle(claimed[i]->payment.transactionId);
+            } else {
+                refundPayment(*claimed[i]);
+            }
+        }
+        complete(*claimed[i], results[i]);
+    }
+}
+
+void BookingEngine::submitPayment(std::unique_ptr<PendingBooking> pending) {
+    PaymentRequest payment;
+    payment.amount = pending->request.totalPrice;
+    payment.method = pending->request.paymentMethod;
+    copyString(payment.reference, pending->request.passengerName, sizeof(payment.reference));
+
+    {
+        std::lock_guard<std::mutex> guard(queueMutex);
+        paymentsInFlight++;
+    }
+    // The processor holds the request until its callback hands it back
+    PendingBooking* inFlight = pending.release();
+    paymentProcessor->submit(payment, [this, inFlight](const PaymentResult& result) {
+        paymentCompleted(inFlight, result);
+    });
+}
+
+void BookingEngine::paymentCompleted(PendingBooking* pending, const PaymentResult& payment) {
+    pending->paid = true;
+    pending->payment = payment;
+
+    // Notify under the lock: once the last payment is back a stopping engine
+    // may be destroyed, so nothing may touch it after the mutex is released.
+    // notify_all so a stopping worker also sees the last payment come home.
+    std::lock_guard<std::mutex> guard(queueMutex);
+    queue.push_back(std::unique_ptr<PendingBooking>(pending));
+    paymentsInFlight--;
+    queueReady.notify_all();
+}
+
+void BookingEngine::refundPayment(const PendingBooking& pending) {
+    {
+        std::lock_guard<std::mutex> guard(queueMutex);
+        refundsInFlight++;
+    }
+    paymentProcessor->refund(pending.payment.transactionId, pending.request.totalPrice,
+                             [this](const PaymentResult& refund) { refundCompleted(refund); });
+}
+
+void BookingEngine::refundCompleted(const PaymentResult& refund) {
+    if (!refund.approved) {
+        std::cout << "Error: Refund of " << refund.transactionId << " failed: " << refund.message << std::endl;
+    }
+
+    // As in paymentCompleted, nothing may touch the engine after the mutex is released
+    std::lock_guard<std::mutex> guard(queueMutex);
+    refundsInFlight--;
+    queueReady.notify_all();
+}
+
+bool BookingEngine::prepareFlight(const char* flightNumber) {
+    if (seatClaims.hasFlight(flightNumber)) return true;
+
+    // First request for this flight: seed its claims from the stored bookings
+    globalLock.lock();
+    bool found = false;
+    try {
+        bookingManager.reloadBookings();
+        if (flightList.getFlightCount() == 0) {
+            flightList.loadFlightsFromFile("data/flights.json");
+        }
+        found = flightList.getFlightByNumber(flightNumber) != nullptr;
+        if (found) {
+            std::uint64_t occupied[SeatOccupancy::WORD_COUNT];
+            bookingManager.getOccupiedSeatWords(flightNumber, occupied);
+            seatClaims.addFlight(flightNumber, occupied);
+        }
+    } catch (const std::exception& e) {
+        std::cout << "Error: Cannot load flight " << flightNumber << ": " << e.what() << std::endl;
+    }
+    globalLock.unlock();
+    return found;
+}
+
+void BookingEngine::commitBatch(std::vector<PendingBooking*>& claimed, std::vector<BookingResult>& results) {
+    // Flight stripes in ascending order, then the global lock, as the interactive flows do
+    std::vector<int> stripes;
+    for (PendingBooking* pending : claimed) {
+        stripes.push_back(LockStripes::stripeFor(pending->request.flightNumber));
+    }
+    std::sort(stripes.begin(), stripes.end());
+    stripes.erase(std::unique(stripes.begin(), stripes.end()), stripes.end());
+
+    for (int stripe : stripes) {
+        flightLocks.forStripe(stripe).lock();
+    }
+    globalLock.lock();
+
+    try {
+        // One refresh and one catalog write for the whole batch
+        bookingManager.reloadBookings();
+        flightList.loadFlightsFromFile("data/flights.json");
+
+        bool catalogChanged = false;
+        for (size_t i = 0; i < claimed.size(); i++) {
+            const BookingRequest& request = claimed[i]->request;
+            Flight* flight = flightList.getFlightByNumber(request.flightNumber);
+            if (!flight) {
+                results[i] = BookingResult{BookingResult::FLIGHT_NOT_FOUND, -1};
+                continue;
+            }
+            if (!bookingManager.isSeatAvailable(request.flightNumber, request.seatNumber, 0)) {
+                // Booked or held by another process since the claims were seeded.
+                // A hold may still lapse, so only a booked seat keeps its claim.
+                // A paid request that loses its seat here is refunded by the caller.
+                if (!bookingManager.isSeatOccupied(request.flightNumber, request.seatNumber)) {
+                    seatClaims.release(request.flightNumber, request.seatNumber);
+                }
+                results[i] = BookingResult{BookingResult::SEAT_TAKEN, -1};
+                continue;
+            }
+
+            int bookingId = bookingManager.createBooking(request.passengerName, flight->getFlightNumber(),
+                                                         flight->getOrigin(), flight->getDestination(),
+                                                         flight->getDepartureDate(), flight->getDepartureTime(),
+                                                         request.seatNumber, request.cabinClass,
+                                                         request.totalPrice > 0.0 ? request.totalPrice
+                                                                                  : flight->getBasePrice() + 50.0);
+            if (bookingId == -1) continue;
+
+            flight->setAvailableSeats(flight->getAvailableSeats() - 1);
+            flight->bumpVersion();
+            catalogChanged = true;
+            results[i] = BookingResult{BookingResult::BOOKED, bookingId};
+        }
+
+        if (catalogChanged) {
+            flightList.saveFlightsToFile("data/flights.json");
+        }
+    } catch (const std::exception& e) {
+        std::cout << "Error: Booking batch failed: " << e.what() << std::endl;
+    }
+
+    globalLock.unlock();
+    for (auto it = stripes.rbegin(); it != stripes.rend(); ++it) {
+        flightLocks.forStripe(*it).unlock();
+    }
+}
+
+void BookingEngine::complete(PendingBooking& pending, const BookingResult& result) {
+    if (result.status == BookingResult::BOOKED) {
+        booked++;
+    } else {
+        failed++;
+    }
+    long long elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - firstSubmit).count();
+    long long seen = lastCompletionMicros.load();
+    while (elapsed > seen && !lastCompletionMicros.compare_exchange_weak(seen, elapsed)) {}
+    pending.result.set_value(result);
+}
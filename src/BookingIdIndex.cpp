@@ -0,0 +1,70 @@
+#include "BookingIdIndex.h"
+
+const int BookingIdIndex::NO_SLOT;
+const int BookingIdIndex::CANCELLED;
+
+BookingIdIndex::BookingIdIndex() : baseId(0) {}
+
+BookingIdIndex::~BookingIdIndex() {}
+
+void BookingIdIndex::setSlot(int bookingId, int slot) {
+    if (!ensureRange(bookingId)) return;
+    slots[bookingId - baseId] = slot;
+}
+
+void BookingIdIndex::markCancelled(int bookingId) {
+    if (!ensureRange(bookingId)) return;
+    slots[bookingId - baseId] = CANCELLED;
+}
+
+int BookingIdIndex::findSlot(int bookingId) const {
+    if (bookingId < baseId || bookingId - baseId >= static_cast<int>(slots.size())) {
+        return NO_SLOT;
+    }
+    return slots[bookingId - baseId];
+}
+
+bool BookingIdIndex::isCancelled(int bookingId) const {
+    return findSlot(bookingId) == CANCELLED;
+}
+
+void BookingIdIndex::reset(int minId, int maxId) {
+    slots.clear();
+    if (minId <= 0 || maxId < minId) {
+        baseId = 0;
+        return;
+    }
+    baseId = minId;
+    slots.assign(maxId - minId + 1, NO_SLOT);
+}
+
+void BookingIdIndex::clear() {
+    slots.clear();
+    baseId = 0;
+}
+
+bool BookingIdIndex::ensureRange(int bookingId) {
+    if (bookingId <= 0) return false;
+
+    if (slots.empty()) {
+        baseId = bookingId;
+        slots.assign(1, NO_SLOT);
+        return true;
+    }
+
+    // IDs below the base are rare (hand-edited data); shift the table down
+    if (bookingId < baseId) {
+        slots.insert(slots.begin(), baseId - bookingId, NO_SLOT);
+        baseId = bookingId;
+        return true;
+    }
+
+    int offset = bookingId - baseId;
+    if (offset >= static_cast<int>(slots.size())) {
+        // Grow geometrically so sequential allocation is amortized O(1)
+        std::size_t newSize = slots.size() * 2;
+        if (newSize <= static_cast<std::size_t>(offset)) newSize = offset + 1;
+        slots.resize(newSize, NO_SLOT);
+    }
+    return true;
+}
@@ -1,13 +1,58 @@
 #include "BookingManager.h"
+#include "Date.h"
 #include "StringUtils.h"
+#include "JsonStreamReader.h"
+#include "FileLock.h"
 #include <iostream>
 #include <fstream>
 #include <ctime>
 #include <cstdlib>
 #include <cstdio>
-
-BookingManager::BookingManager() : bookingCount(0), nextBookingId(1000) {
-    srand(static_cast<unsigned int>(time(nullptr)));
+#include <filesystem>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+// Streams a C string as a quoted JSON string. Quotes, backslashes and control
+// characters are escaped, so a record always parses back to the same text.
+namespace {
+struct JsonString {
+    const char* text;
+    explicit JsonString(const char* text) : text(text) {}
+};
+
+std::ostream& operator<<(std::ostream& out, const JsonString& value) {
+    out << '"';
+    for (const char* p = value.text; *p; p++) {
+        unsigned char c = static_cast<unsigned char>(*p);
+        if (c == '"' || c == '\\') {
+            out << '\\' << *p;
+        } else if (c == '\n') {
+            out << "\\n";
+        } else if (c == '\t') {
+            out << "\\t";
+        } else if (c == '\r') {
+            out << "\\r";
+        } else if (c < 0x20) {
+            char escaped[8];
+            snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+            out << escaped;
+        } else {
+            out << *p;
+        }
+    }
+    return out << '"';
+}
+} // namespace
+
+BookingManager::BookingManager()
+    : liveSlotsStale(true), nextBookingId(1000), journalRecordCount(0), journalOffset(0), journalGeneration(-1),
+      useBinaryStore(false), binaryChangeCount(0), storageLock(nullptr) {
+    std::random_device seed;
+    holdIdSource.seed((static_cast<std::uint64_t>(seed()) << 32) ^ seed() ^ static_cast<std::uint64_t>(time(nullptr)));
+    snapshotPath[0] = '\0';
+    journalPath[0] = '\0';
+    setStoragePaths("data/bookings.json");
 }
 
 BookingManager::~BookingManager() {}
@@ -17,12 +62,20 @@ int BookingManager::createBooking(const char* passengerName, const char* flightN
                                   const char* departureDate, const char* departureTime,
                                   const char* seatNumber, const char* cabinClass,
                                   double totalPrice) {
-    if (bookingCount >= MAX_BOOKINGS) {
-        std::cout << "Error: Maximum bookings limit reached." << std::endl;
+    // The ID comes from this process's leased block, so it needs no storage lock
+    int bookingId = idAllocator.allocate(nextBookingId);
+    if (bookingId == -1) {
+        std::cout << "Error: Could not allocate a booking ID." << std::endl;
         return -1;
     }
 
-    int bookingId = nextBookingId++;
+    // Catch up before appending; a caller that already holds the lock is
+    // expected to have refreshed under it
+    bool lockTaken = lockStorage();
+    if (lockTaken) {
+        catchUpWithStorage();
+    }
+    if (bookingId >= nextBookingId) nextBookingId = bookingId + 1;
 
     Booking newBooking(bookingId, passengerName, flightNumber, origin, destination,
                        departureDate, departureTime, seatNumber, cabinClass, totalPrice);
@@ -37,8 +90,16 @@ int BookingManager::createBooking(const char* passengerName, const char* flightN
     newBooking.setBookingTime(currentTime);
     newBooking.setBookingStatus("confirmed");
 
-    bookings[bookingCount] = newBooking;
-    bookingCount++;
+    appendBooking(newBooking);
+    if (!persistMutation("create", newBooking)) {
+        // Never reached storage, so it must not exist in memory either
+        removeBookingAt(bookings.slotCount() - 1);
+        idIndex.setSlot(bookingId, BookingIdIndex::NO_SLOT);
+        unlockStorage(lockTaken);
+        std::cout << "Error: Booking could not be saved. Please try again." << std::endl;
+        return -1;
+    }
+    unlockStorage(lockTaken);
 
     std::cout << "Booking created successfully with ID: " << bookingId << std::endl;
     return bookingId;
@@ -46,7 +107,7 @@ int BookingManager::createBooking(const char* passengerName, const char* flightN
 
 bool BookingManager::modifyBooking(int bookingId) {
     // Load fresh data first
-    loadBookingsFromFile("data/bookings.json");
+    reloadBookings();
 
     Booking* booking = findBookingById(bookingId);
     if (!booking) {
@@ -86,7 +147,9 @@ bool BookingManager::modifyBooking(int bookingId) {
             std::cout << "Enter new seat number: ";
             char newSeat[5];
             std::cin.getline(newSeat, 5);
+            seatOccupancy.release(booking->getFlightNumber(), booking->getSeatNumber());
             booking->setSeatNumber(newSeat);
+            occupySeat(booking->getFlightNumber(), newSeat);
             // Add seat change fee
             booking->setTotalPrice(booking->getTotalPrice() + 25.0);
             std::cout << "Seat change fee of $25 applied." << std::endl;
@@ -109,8 +172,8 @@ bool BookingManager::modifyBooking(int bookingId) {
     if (modified) {
         updateBookingStatus(bookingId, "modified");
 
-        // Save changes immediately
-        if (saveBookingsToFile("data/bookings.json")) {
+        // Save changes immediately as a single record
+        if (persistMutation("update", *booking)) {
             std::cout << "Booking modified and saved successfully!" << std::endl;
             return true;
         } else {
@@ -124,11 +187,15 @@ bool BookingManager::modifyBooking(int bookingId) {
 
 bool BookingManager::cancelBooking(int bookingId) {
     // Load fresh data first
-    loadBookingsFromFile("data/bookings.json");
+    reloadBookings();
 
     Booking* booking = findBookingById(bookingId);
     if (!booking) {
-        std::cout << "Booking not found with ID: " << bookingId << std::endl;
+        if (idIndex.isCancelled(bookingId)) {
+            std::cout << "Booking " << bookingId << " has already been cancelled." << std::endl;
+        } else {
+            std::cout << "Booking not found with ID: " << bookingId << std::endl;
+        }
         return false;
     }
 
@@ -141,7 +208,7 @@ bool BookingManager::cancelBooking(int bookingId) {
     booking->displayBookingDetails();
 
     // Calculate cancellation fee
-    int daysUntilDeparture = 10; // Simplified
+    int daysUntilDeparture = Date::daysUntil(booking->getDepartureDay());
     double cancellationFee = calculateCancellationFee(bookingId, daysUntilDeparture);
     double refundAmount = booking->getTotalPrice() - cancellationFee;
 
@@ -157,23 +224,14 @@ bool BookingManager::cancelBooking(int bookingId) {
 
     if (confirm == 'y' || confirm == 'Y') {
         // Find the booking index and remove it
-        int bookingIndex = -1;
-        for (int i = 0; i < bookingCount; i++) {
-            if (bookings[i].getBookingId() == bookingId) {
-                bookingIndex = i;
-                break;
-            }
-        }
+        int bookingIndex = idIndex.findSlot(bookingId);
 
         if (bookingIndex >= 0) {
-            // Shift all bookings after this one back
-            for (int i = bookingIndex; i < bookingCount - 1; i++) {
-                bookings[i] = bookings[i + 1];
-            }
-            bookingCount--;
+            Booking cancelled = bookings[bookingIndex];
+            removeBookingAt(bookingIndex);
 
             // Save changes
-            if (saveBookingsToFile("data/bookings.json")) {
+            if (persistMutation("cancel", cancelled)) {
                 std::cout << "Booking cancelled successfully!" << std::endl;
                 std::cout << "Refund of $" << refundAmount << " will be processed in 5-7 business days." << std::endl;
                 return true;
@@ -189,29 +247,29 @@ bool BookingManager::cancelBooking(int bookingId) {
 
 // **Private** helper method
 Booking* BookingManager::findBookingById(int bookingId) {
-    for (int i = 0; i < bookingCount; i++) {
-        if (bookings[i].getBookingId() == bookingId) {
-            return &bookings[i];
-        }
-    }
-    return nullptr;
+    int slot = idIndex.findSlot(bookingId);
+    return slot >= 0 ? &bookings[slot] : nullptr;
 }
 
 // **Public** getter methods
 const Booking* BookingManager::getBooking(int index) const {
-    if (index >= 0 && index < bookingCount) {
-        return &bookings[index];
+    if (index < 0 || index >= bookings.size()) {
+        return nullptr;
+    }
+    if (liveSlotsStale) {
+        liveSlots.clear();
+        liveSlots.reserve(bookings.size());
+        for (int i = 0; i < bookings.slotCount(); i++) {
+            if (bookings.isLive(i)) liveSlots.push_back(i);
+        }
+        liveSlotsStale = false;
     }
-    return nullptr;
+    return &bookings[liveSlots[index]];
 }
 
 const Booking* BookingManager::getBookingById(int bookingId) const {
-    for (int i = 0; i < bookingCount; i++) {
-        if (bookings[i].getBookingId() == bookingId) {
-            return &bookings[i];
-        }
-    }
-    return nullptr;
+    int slot = idIndex.findSlot(bookingId);
+    return slot >= 0 ? &bookings[slot] : nullptr;
 }
 
 void BookingManager::displayBookingDetails(int bookingId) {
@@ -225,17 +283,19 @@ void BookingManager::displayBookingDetails(int bookingId) {
 }
 
 void BookingManager::displayAllBookings() {
-    if (bookingCount == 0) {
+    if (bookings.size() == 0) {
         std::cout << "No bookings found." << std::endl;
         return;
     }
 
     std::cout << "\n=== ALL BOOKINGS ===" << std::endl;
-    std::cout << "Total bookings: " << bookingCount << std::endl;
+    std::cout << "Total bookings: " << bookings.size() << std::endl;
     std::cout << "=================" << std::endl;
 
-    for (int i = 0; i < bookingCount; i++) {
-        std::cout << "\nBooking " << (i + 1) << ":" << std::endl;
+    int shown = 0;
+    for (int i = 0; i < bookings.slotCount(); i++) {
+        if (!bookings.isLive(i)) continue;
+        std::cout << "\nBooking " << (++shown) << ":" << std::endl;
         bookings[i].displayBookingDetails();
         std::cout << "-------------------" << std::endl;
     }
@@ -250,7 +310,8 @@ void BookingManager::displayBookingsByPassenger(const char* passengerName) {
     bool found = false;
     std::cout << "\n=== BOOKINGS FOR: " << passengerName << " ===" << std::endl;
 
-    for (int i = 0; i < bookingCount; i++) {
+    for (int i = 0; i < bookings.slotCount(); i++) {
+        if (!bookings.isLive(i)) continue;
         // Use case-insensitive comparison and substring matching
         if (stringCompareNoCase(bookings[i].getPassengerName(), passengerName) ||
             containsIgnoreCase(bookings[i].getPassengerName(), passengerName)) {
@@ -266,23 +327,28 @@ void BookingManager::displayBookingsByPassenger(const char* passengerName) {
 }
 
 int BookingManager::findBookingByPnr(const char* pnr) {
-    for (int i = 0; i < bookingCount; i++) {
-        if (stringCompare(bookings[i].getPnr(), pnr)) {
-            return bookings[i].getBookingId();
-        }
+    // A codec PNR names its booking; confirm it in case a legacy PNR happens to decode
+    int bookingId = pnrCodec.decode(pnr);
+    const Booking* booking = bookingId >= 0 ? getBookingById(bookingId) : nullptr;
+    if (booking && !isLegacyPnr(*booking)) {
+        return bookingId;
     }
-    return -1;
+    return pnrIndex.find(pnr);
 }
 
 void BookingManager::searchBookingsByFlight(const char* flightNumber) {
     bool found = false;
     std::cout << "\n=== BOOKINGS FOR FLIGHT: " << flightNumber << " ===" << std::endl;
 
-    for (int i = 0; i < bookingCount; i++) {
-        if (stringCompare(bookings[i].getFlightNumber(), flightNumber)) {
-            bookings[i].displayBookingDetails();
-            std::cout << "-------------------" << std::endl;
-            found = true;
+    const std::vector<int>* ids = flightIndex.getBookingIds(flightNumber);
+    if (ids) {
+        for (int bookingId : *ids) {
+            const Booking* booking = getBookingById(bookingId);
+            if (booking) {
+                booking->displayBookingDetails();
+                std::cout << "-------------------" << std::endl;
+                found = true;
+            }
         }
     }
 
@@ -291,6 +357,76 @@ void BookingManager::searchBookingsByFlight(const char* flightNumber) {
     }
 }
 
+bool BookingManager::isSeatOccupied(const char* flightNumber, const char* seatNumber) const {
+    return seatOccupancy.isOccupied(flightNumber, seatNumber);
+}
+
+bool BookingManager::isSeatOccupied(const char* flightNumber, int row, int column) const {
+    return seatOccupancy.isOccupied(flightNumber, row, column);
+}
+
+int BookingManager::getOccupiedSeatCount(const char* flightNumber) const {
+    return seatOccupancy.getOccupiedCount(flightNumber);
+}
+
+void BookingManager::getOccupiedSeatWords(const char* flightNumber, std::uint64_t* words) const {
+    seatOccupancy.copyWords(flightNumber, words);
+}
+
+const std::vector<int>* BookingManager::getBookingIdsForFlight(const char* flightNumber) const {
+    return flightIndex.getBookingIds(flightNumber);
+}
+
+std::uint64_t BookingManager::placeSeatHold(const char* flightNumber, const char* seatNumber,
+                                            int ttlSeconds, std::uint64_t holdId) {
+    // Under the lock, after catching up, so two processes cannot hold one seat
+    bool lockTaken = lockStorage();
+    catchUpWithStorage();
+
+    long long now = currentEpochSeconds();
+    std::uint64_t placed = 0;
+    if (!seatOccupancy.isOccupied(flightNumber, seatNumber)) {
+        while (holdId == 0) holdId = holdIdSource();
+        if (seatHolds.place(holdId, flightNumber, seatNumber, now + ttlSeconds, now)) {
+            placed = holdId;
+            if (!useBinaryStore) {
+                appendHoldRecord(*seatHolds.find(holdId, now));
+            }
+        }
+    }
+    unlockStorage(lockTaken);
+    return placed;
+}
+
+void BookingManager::releaseSeatHold(std::uint64_t holdId) {
+    bool lockTaken = lockStorage();
+    if (seatHolds.find(holdId, currentEpochSeconds())) {
+        seatHolds.release(holdId);
+        if (!useBinaryStore) {
+            appendReleaseRecord(holdId);
+        }
+    }
+    unlockStorage(lockTaken);
+}
+
+bool BookingManager::isSeatHoldActive(std::uint64_t holdId) const {
+    return holdId != 0 && seatHolds.find(holdId, currentEpochSeconds()) != nullptr;
+}
+
+std::uint64_t BookingManager::getSeatHolder(const char* flightNumber, int row, int column) const {
+    return seatHolds.holderOf(flightNumber, row, column, currentEpochSeconds());
+}
+
+bool BookingManager::isSeatAvailable(const char* flightNumber, const char* seatNumber, std::uint64_t ownHoldId) const {
+    int row, column;
+    if (!SeatOccupancy::parseSeat(seatNumber, row, column) ||
+        seatOccupancy.isOccupied(flightNumber, row, column)) {
+        return false;
+    }
+    std::uint64_t holder = getSeatHolder(flightNumber, row, column);
+    return holder == 0 || holder == ownHoldId;
+}
+
 bool BookingManager::isValidBookingId(int bookingId) {
     return findBookingById(bookingId) != nullptr;
 }
@@ -309,16 +445,18 @@ bool BookingManager::modifyPassengerName(int bookingId, const char* newName) {
 
     booking->setPassengerName(newName);
     updateBookingStatus(bookingId, "modified");
-    return true;
+    return persistMutation("update", *booking);
 }
 
 bool BookingManager::modifySeatNumber(int bookingId, const char* newSeat) {
     Booking* booking = findBookingById(bookingId);
     if (!booking) return false;
 
+    seatOccupancy.release(booking->getFlightNumber(), booking->getSeatNumber());
     booking->setSeatNumber(newSeat);
+    occupySeat(booking->getFlightNumber(), newSeat);
     updateBookingStatus(bookingId, "modified");
-    return true;
+    return persistMutation("update", *booking);
 }
 
 bool BookingManager::modifyCabinClass(int bookingId, const char* newClass) {
@@ -327,7 +465,7 @@ bool BookingManager::modifyCabinClass(int bookingId, const char* newClass) {
 
     booking->setCabinClass(newClass);
     updateBookingStatus(bookingId, "modified");
-    return true;
+    return persistMutation("update", *booking);
 }
 
 bool BookingManager::modifyDepartureDate(int bookingId, const char* newDate) {
@@ -336,187 +474,707 @@ bool BookingManager::modifyDepartureDate(int bookingId, const char* newDate) {
 
     booking->setDepartureDate(newDate);
     updateBookingStatus(bookingId, "modified");
-    return true;
+    return persistMutation("update", *booking);
 }
 
 bool BookingManager::saveBookingsToFile(const char* filename) {
-    std::ofstream file(filename);
+    bool lockTaken = lockStorage();
+    bool saved = saveBookingsToStorage(filename);
+    unlockStorage(lockTaken);
+    return saved;
+}
+
+bool BookingManager::saveBookingsToStorage(const char* filename) {
+    if (isBinaryStorePath(filename)) {
+        return saveBinaryStore(filename);
+    }
+
+    // Write to a temporary file first so a crash never leaves a half-written snapshot
+    char tempPath[MAX_PATH_LENGTH + 8];
+    snprintf(tempPath, sizeof(tempPath), "%s.tmp", filename);
+
+    std::ofstream file(tempPath);
     if (!file.is_open()) {
         std::cout << "Error: Cannot open file for writing: " << filename << std::endl;
         return false;
     }
 
     // Write JSON format manually
+    file << std::setprecision(std::numeric_limits<double>::max_digits10);
     file << "{\n";
     file << "  \"bookings\": [\n";
 
-    for (int i = 0; i < bookingCount; i++) {
+    int written = 0;
+    for (int i = 0; i < bookings.slotCount(); i++) {
+        if (!bookings.isLive(i)) continue;
+        if (written++ > 0) file << ",\n";
         file << "    {\n";
         file << "      \"bookingId\": " << bookings[i].getBookingId() << ",\n";
-        file << "      \"pnr\": \"" << bookings[i].getPnr() << "\",\n";
-        file << "      \"passengerName\": \"" << bookings[i].getPassengerName() << "\",\n";
-        file << "      \"flightNumber\": \"" << bookings[i].getFlightNumber() << "\",\n";
-        file << "      \"origin\": \"" << bookings[i].getOrigin() << "\",\n";
-        file << "      \"destination\": \"" << bookings[i].getDestination() << "\",\n";
-        file << "      \"departureDate\": \"" << bookings[i].getDepartureDate() << "\",\n";
-        file << "      \"departureTime\": \"" << bookings[i].getDepartureTime() << "\",\n";
-        file << "      \"seatNumber\": \"" << bookings[i].getSeatNumber() << "\",\n";
-        file << "      \"cabinClass\": \"" << bookings[i].getCabinClass() << "\",\n";
+        file << "      \"pnr\": " << JsonString(bookings[i].getPnr()) << ",\n";
+        file << "      \"passengerName\": " << JsonString(bookings[i].getPassengerName()) << ",\n";
+        file << "      \"flightNumber\": " << JsonString(bookings[i].getFlightNumber()) << ",\n";
+        file << "      \"origin\": " << JsonString(bookings[i].getOrigin()) << ",\n";
+        file << "      \"destination\": " << JsonString(bookings[i].getDestination()) << ",\n";
+        file << "      \"departureDate\": " << JsonString(bookings[i].getDepartureDate()) << ",\n";
+        file << "      \"departureTime\": " << JsonString(bookings[i].getDepartureTime()) << ",\n";
+        file << "      \"seatNumber\": " << JsonString(bookings[i].getSeatNumber()) << ",\n";
+        file << "      \"cabinClass\": " << JsonString(bookings[i].getCabinClass()) << ",\n";
         file << "      \"totalPrice\": " << bookings[i].getTotalPrice() << ",\n";
-        file << "      \"bookingStatus\": \"" << bookings[i].getBookingStatus() << "\",\n";
-        file << "      \"bookingDate\": \"" << bookings[i].getBookingDate() << "\",\n";
-        file << "      \"bookingTime\": \"" << bookings[i].getBookingTime() << "\"\n";
+        file << "      \"bookingStatus\": " << JsonString(bookings[i].getBookingStatus()) << ",\n";
+        file << "      \"bookingDate\": " << JsonString(bookings[i].getBookingDate()) << ",\n";
+        file << "      \"bookingTime\": " << JsonString(bookings[i].getBookingTime()) << "\n";
         file << "    }";
-        if (i < bookingCount - 1) file << ",";
-        file << "\n";
     }
+    if (written > 0) file << "\n";
 
     file << "  ],\n";
     file << "  \"nextBookingId\": " << nextBookingId << "\n";
     file << "}\n";
 
     file.close();
+    // The journal is truncated below, so the snapshot must be on disk before it replaces the old one
+    if (file.fail() || !JournalFile::syncPath(tempPath)) {
+        std::cout << "Error: Failed writing bookings to " << tempPath << std::endl;
+        return false;
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(tempPath, filename, ec);
+    if (ec) {
+        std::cout << "Error: Cannot replace " << filename << ": " << ec.message() << std::endl;
+        return false;
+    }
+
+    // The snapshot now contains every journaled change, so the journal can start over
+    // The header tells other processes their journal offsets are void
+    if (stringCompare(filename, snapshotPath)) {
+        int generation = readJournalGeneration();
+        if (journalGeneration > generation) generation = journalGeneration;
+        journalGeneration = generation + 1;
+
+        char header[64];
+        int headerLength = snprintf(header, sizeof(header), "{\"op\": \"checkpoint\", \"generation\": %d}\n",
+                                    journalGeneration);
+        long long headerStart = 0;
+        if (!openJournal() || !journalFile.truncate() ||
+            !journalFile.append(header, headerLength, headerStart) || !journalFile.sync()) {
+            std::cout << "Error: Cannot start a new journal: " << journalPath << std::endl;
+            return false;
+        }
+        journalOffset = headerStart + headerLength;
+        journalRecordCount = 0;
+
+        // Holds are not part of the snapshot; carry the live ones over
+        std::vector<SeatHold> liveHolds;
+        seatHolds.collectLive(liveHolds, currentEpochSeconds());
+        for (const SeatHold& hold : liveHolds) {
+            appendHoldRecord(hold);
+        }
+    }
+
     std::cout << "Bookings saved successfully to " << filename << std::endl;
     return true;
 }
 
-bool BookingManager::loadBookingsFromFile(const char* filename) {
-    std::ifstream file(filename);
-    if (!file.is_open()) {
-        std::cout << "Warning: Cannot open file for reading: " << filename << std::endl;
-        std::cout << "Starting with empty booking list." << std::endl;
+bool BookingManager::checkpoint() {
+    bool lockTaken = lockStorage();
+    bool saved;
+    if (useBinaryStore) {
+        saved = binaryStore.sync();
+    } else {
+        // Fold in records other processes appended since the last load,
+        // otherwise truncating the journal would drop them
+        saved = catchUpWithStorage() && saveBookingsToStorage(snapshotPath);
+    }
+    unlockStorage(lockTaken);
+    return saved;
+}
+
+void BookingManager::setStorageLock(FileLock* lock) {
+    storageLock = lock;
+}
+
+bool BookingManager::lockStorage() {
+    // Nested calls from a thread that already holds the lock run under it
+    if (!storageLock || storageLock->isHeldByCurrentThread()) {
+        return false;
+    }
+    return storageLock->lock();
+}
+
+void BookingManager::unlockStorage(bool taken) {
+    if (taken) {
+        storageLock->unlock();
+    }
+}
+
+bool BookingManager::lockStorageShared() {
+    if (!storageLock || storageLock->isHeldByCurrentThread()) {
         return false;
     }
+    return storageLock->lockShared();
+}
+
+void BookingManager::unlockStorageShared(bool taken) {
+    if (taken) {
+        storageLock->unlockShared();
+    }
+}
+
+bool BookingManager::loadBookingsFromFile(const char* filename) {
+    bool lockTaken = lockStorage();
+    bool loaded = loadBookingsFromStorage(filename, true);
+    unlockStorage(lockTaken);
+    return loaded;
+}
+
+bool BookingManager::loadBookingsFromStorage(const char* filename, bool repairTail) {
+    bool sameStorage = stringCompare(filename, snapshotPath);
+    setStoragePaths(filename);
 
     // Reset counters
-    bookingCount = 0;
+    bookings.clear();
+    liveSlotsStale = true;
+    pnrIndex.clear();
+    idIndex.clear();
+    seatOccupancy.clear();
+    flightIndex.clear();
+    // Journal holds are rebuilt by the replay below. The binary store does not
+    // persist holds, so reloading the same store keeps this process's holds.
+    if (!useBinaryStore || !sameStorage) {
+        seatHolds.clear();
+    }
     nextBookingId = 1000;
+    journalGeneration = -1;
+    journalOffset = 0;
+
+    if (useBinaryStore) {
+        return loadBinaryStore(filename);
+    }
 
-    // Read file content into buffer
-    char buffer[50000]; // Large buffer for file content
-    char* content = buffer;
-    int contentSize = 0;
+    bool loaded = loadSnapshotFromFile(filename);
+    rebuildIndexes();
 
-    // Read entire file
-    while (file.good() && contentSize < sizeof(buffer) - 1) {
-        file.read(&content[contentSize], 1);
-        if (file.gcount() > 0) {
-            contentSize++;
-        }
+    // Apply every change recorded since the last checkpoint
+    journalGeneration = 0;
+    journalRecordCount = replayJournal(journalPath, 0, repairTail);
+    if (journalRecordCount > 0) {
+        std::cout << "Replayed " << journalRecordCount << " journal records from " << journalPath << std::endl;
     }
-    content[contentSize] = '\0';
-    file.close();
 
-    if (contentSize == 0) {
-        std::cout << "File is empty. Starting with no bookings." << std::endl;
+    if (!loaded && journalRecordCount == 0) {
         return false;
     }
 
-    // Parse nextBookingId first
-    char* nextIdPos = findStringInBuffer(content, "\"nextBookingId\":");
-    if (nextIdPos) {
-        char* colonPos = findCharInBuffer(nextIdPos, ':');
-        if (colonPos) {
-            nextBookingId = parseIntFromBuffer(colonPos + 1);
-        }
+    std::cout << "Loaded " << bookings.size() << " bookings from " << filename << std::endl;
+    std::cout << "Next booking ID will be: " << nextBookingId << std::endl;
+    return true;
+}
+
+bool BookingManager::reloadBookings() {
+    bool lockTaken = lockStorage();
+    bool loaded = catchUpWithStorage();
+    unlockStorage(lockTaken);
+    return loaded;
+}
+
+bool BookingManager::refreshBookings() {
+    if (useBinaryStore) {
+        // Readers share the lock so a write is never seen half done
+        bool lockTaken = lockStorageShared();
+        bool caughtUp = catchUpWithBinaryStore() || loadBookingsFromStorage(snapshotPath, false);
+        unlockStorageShared(lockTaken);
+        return caughtUp;
     }
 
-    // Parse bookings array
-    char* bookingsPos = findStringInBuffer(content, "\"bookings\":");
-    if (!bookingsPos) {
-        std::cout << "No bookings array found in file." << std::endl;
+    // Lock-free read of the journal tail. Complete lines are never rewritten,
+    // so only an unterminated last line (an append in progress) is left for later.
+    if (canReplayJournalTail()) {
+        journalRecordCount += replayJournal(journalPath, journalOffset, false);
+        seatHolds.expire(currentEpochSeconds());
+        return true;
+    }
+
+    // A full load must not see a checkpoint half done, so it shares the lock
+    // with other readers; a reader never writes, even to repair a torn line
+    bool lockTaken = lockStorageShared();
+    bool loaded = loadBookingsFromStorage(snapshotPath, false);
+    unlockStorageShared(lockTaken);
+    return loaded;
+}
+
+bool BookingManager::catchUpWithStorage() {
+    if (useBinaryStore) {
+        return catchUpWithBinaryStore() || loadBookingsFromStorage(snapshotPath, true);
+    }
+    if (!canReplayJournalTail()) {
+        return loadBookingsFromStorage(snapshotPath, true);
+    }
+
+    int replayed = replayJournal(journalPath, journalOffset, true);
+    journalRecordCount += replayed;
+    seatHolds.expire(currentEpochSeconds());
+    if (replayed > 0) {
+        std::cout << "Replayed " << replayed << " journal records from " << journalPath << std::endl;
+    }
+    return true;
+}
+
+bool BookingManager::canReplayJournalTail() {
+    // The first load always goes through a full load; the binary store has its own catch-up
+    if (useBinaryStore || journalGeneration < 0) {
         return false;
     }
 
-    // Find the opening bracket of bookings array
-    char* arrayStart = findCharInBuffer(bookingsPos, '[');
-    if (!arrayStart) {
-        std::cout << "Invalid bookings array format." << std::endl;
+    std::error_code ec;
+    std::uintmax_t size = std::filesystem::file_size(journalPath, ec);
+    if (ec) size = 0;
+    return size >= static_cast<std::uintmax_t>(journalOffset) &&
+           readJournalGeneration() == journalGeneration;
+}
+
+bool BookingManager::loadSnapshotFromFile(const char* filename) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        std::cout << "Warning: Cannot open file for reading: " << filename << std::endl;
+        std::cout << "Starting with empty booking list." << std::endl;
         return false;
     }
 
-    // Parse each booking object
-    char* pos = arrayStart + 1;
-    while (*pos && bookingCount < MAX_BOOKINGS) {
-        // Find next booking object
-        char* objStart = findCharInBuffer(pos, '{');
-        if (!objStart) break;
+    JsonStreamReader reader(file);
+    JsonStreamReader::TokenType token = reader.next();
+    if (token == JsonStreamReader::END_OF_INPUT) {
+        std::cout << "File is empty. Starting with no bookings." << std::endl;
+        return false;
+    }
+    if (token != JsonStreamReader::BEGIN_OBJECT) {
+        std::cout << "Invalid bookings file format." << std::endl;
+        return false;
+    }
 
-        char* objEnd = findMatchingBrace(objStart);
-        if (!objEnd) break;
+    // Single pass over the top-level object; keys may appear in any order
+    bool foundBookings = false;
+    while (reader.next() == JsonStreamReader::KEY) {
+        if (reader.textEquals("nextBookingId")) {
+            reader.next();
+            nextBookingId = reader.getInt();
+        } else if (reader.textEquals("bookings")) {
+            if (reader.next() != JsonStreamReader::BEGIN_ARRAY) {
+                std::cout << "Invalid bookings array format." << std::endl;
+                return false;
+            }
+            foundBookings = true;
 
-        // Extract booking object
-        int objLength = objEnd - objStart + 1;
-        char bookingObj[2000];
-        copyStringN(bookingObj, objStart, objLength);
-        bookingObj[objLength] = '\0';
+            // Parse each booking object
+            while (reader.next() == JsonStreamReader::BEGIN_OBJECT) {
+                Booking booking;
+                if (!readBookingObject(reader, booking, nullptr, 0)) break;
 
-        // Parse booking fields
-        Booking booking;
+                bookings.append(booking);
+            }
+        } else {
+            reader.next();
+            reader.skipValue();
+        }
+    }
 
-        // Parse bookingId
-        int id = parseJsonIntFromObject(bookingObj, "bookingId");
-        if (id > 0) booking.setBookingId(id);
+    if (!foundBookings) {
+        std::cout << "No bookings array found in file." << std::endl;
+        return false;
+    }
+    return true;
+}
 
-        // Parse string fields
-        char tempStr[100];
-        if (parseJsonStringFromObject(bookingObj, "pnr", tempStr, sizeof(tempStr))) {
-            booking.setPnr(tempStr);
+// Maps each string key of a booking object to its Booking setter
+struct BookingStringField {
+    const char* key;
+    void (Booking::*setter)(const char*);
+};
+
+static const BookingStringField BOOKING_STRING_FIELDS[] = {
+    {"pnr", &Booking::setPnr},
+    {"passengerName", &Booking::setPassengerName},
+    {"flightNumber", &Booking::setFlightNumber},
+    {"origin", &Booking::setOrigin},
+    {"destination", &Booking::setDestination},
+    {"departureDate", &Booking::setDepartureDate},
+    {"departureTime", &Booking::setDepartureTime},
+    {"seatNumber", &Booking::setSeatNumber},
+    {"cabinClass", &Booking::setCabinClass},
+    {"bookingStatus", &Booking::setBookingStatus},
+    {"bookingDate", &Booking::setBookingDate},
+    {"bookingTime", &Booking::setBookingTime},
+};
+
+bool BookingManager::readBookingObject(JsonStreamReader& reader, Booking& booking, char* op, int opLen) {
+    // The reader is positioned on the object's opening brace
+    JsonStreamReader::TokenType token;
+    while ((token = reader.next()) == JsonStreamReader::KEY) {
+        char key[32];
+        copyString(key, reader.getText(), sizeof(key));
+
+        JsonStreamReader::TokenType value = reader.next();
+        if (value == JsonStreamReader::BEGIN_OBJECT || value == JsonStreamReader::BEGIN_ARRAY) {
+            if (!reader.skipValue()) return false;
+            continue;
         }
-        if (parseJsonStringFromObject(bookingObj, "passengerName", tempStr, sizeof(tempStr))) {
-            booking.setPassengerName(tempStr);
+        if (value != JsonStreamReader::STRING && value != JsonStreamReader::NUMBER &&
+            value != JsonStreamReader::LITERAL) {
+            return false;
         }
-        if (parseJsonStringFromObject(bookingObj, "flightNumber", tempStr, sizeof(tempStr))) {
-            booking.setFlightNumber(tempStr);
+
+        if (stringCompare(key, "bookingId")) {
+            int id = reader.getInt();
+            if (id > 0) booking.setBookingId(id);
+        } else if (stringCompare(key, "totalPrice")) {
+            double price = reader.getDouble();
+            if (price > 0.0) booking.setTotalPrice(price);
+        } else if (op && stringCompare(key, "op")) {
+            copyString(op, reader.getText(), opLen);
+        } else {
+            for (const BookingStringField& field : BOOKING_STRING_FIELDS) {
+                if (stringCompare(key, field.key)) {
+                    (booking.*field.setter)(reader.getText());
+                    break;
+                }
+            }
         }
-        if (parseJsonStringFromObject(bookingObj, "origin", tempStr, sizeof(tempStr))) {
-            booking.setOrigin(tempStr);
+    }
+    return token == JsonStreamReader::END_OBJECT;
+}
+
+// Storage backends
+bool BookingManager::persistMutation(const char* op, const Booking& booking) {
+    bool lockTaken = lockStorage();
+    bool stored;
+    if (!useBinaryStore) {
+        stored = appendJournalRecord(op, booking);
+    } else {
+        // Binary store: overwrite or tombstone the booking's record in place
+        std::uint64_t changesBefore = binaryStore.getChangeCount();
+        stored = stringCompare(op, "cancel") ? binaryStore.removeBooking(booking.getBookingId())
+                                             : binaryStore.storeBooking(booking);
+        binaryStore.setNextBookingId(nextBookingId);
+        // Skip our own write only if no other process's change is still unapplied before it
+        if (stored && binaryChangeCount == changesBefore) {
+            binaryChangeCount = binaryStore.getChangeCount();
         }
-        if (parseJsonStringFromObject(bookingObj, "destination", tempStr, sizeof(tempStr))) {
-            booking.setDestination(tempStr);
+        if (!stored) {
+            std::cout << "Error: Cannot update booking store: " << snapshotPath << std::endl;
         }
-        if (parseJsonStringFromObject(bookingObj, "departureDate", tempStr, sizeof(tempStr))) {
-            booking.setDepartureDate(tempStr);
+    }
+    unlockStorage(lockTaken);
+    return stored;
+}
+
+bool BookingManager::isBinaryStorePath(const char* filename) {
+    int len = stringLength(filename);
+    return len > 4 && stringCompare(filename + len - 4, ".bin");
+}
+
+bool BookingManager::loadBinaryStore(const char* filename) {
+    // The mapping stays open between reloads, so a reload is a plain record copy
+    if (!binaryStore.isOpen() && !binaryStore.open(filename)) {
+        return false;
+    }
+
+    int recordCount = binaryStore.getRecordCount();
+    Booking booking;
+    for (int slot = 0; slot < recordCount; slot++) {
+        if (binaryStore.readRecord(slot, booking)) {
+            bookings.append(booking);
         }
-        if (parseJsonStringFromObject(bookingObj, "departureTime", tempStr, sizeof(tempStr))) {
-            booking.setDepartureTime(tempStr);
+    }
+    nextBookingId = binaryStore.getNextBookingId();
+    binaryChangeCount = binaryStore.getChangeCount();
+    rebuildIndexes();
+
+    std::cout << "Loaded " << bookings.size() << " bookings from " << filename << std::endl;
+    std::cout << "Next booking ID will be: " << nextBookingId << std::endl;
+    return true;
+}
+
+bool BookingManager::catchUpWithBinaryStore() {
+    // Re-read only the records other processes wrote since the last catch-up
+    std::vector<int> changedSlots;
+    if (!binaryStore.isOpen() || !binaryStore.getChangedSlots(binaryChangeCount, changedSlots)) {
+        return false;
+    }
+
+    Booking booking;
+    for (int slot : changedSlots) {
+        if (binaryStore.readRecord(slot, booking)) {
+            applyJournalRecord("update", booking);
+        } else {
+            Booking cancelled;
+            cancelled.setBookingId(binaryStore.getRecordBookingId(slot));
+            applyJournalRecord("cancel", cancelled);
         }
-        if (parseJsonStringFromObject(bookingObj, "seatNumber", tempStr, sizeof(tempStr))) {
-            booking.setSeatNumber(tempStr);
+    }
+    binaryChangeCount += changedSlots.size();
+
+    int storedNextId = binaryStore.getNextBookingId();
+    if (storedNextId > nextBookingId) nextBookingId = storedNextId;
+    seatHolds.expire(currentEpochSeconds());
+    return true;
+}
+
+bool BookingManager::saveBinaryStore(const char* filename) {
+    if (useBinaryStore && binaryStore.isOpen() && stringCompare(filename, snapshotPath)) {
+        // Every change is already written in place
+        return binaryStore.sync();
+    }
+
+    // Export the in-memory bookings into a fresh store
+    BinaryBookingStore exported;
+    if (!exported.create(filename)) {
+        return false;
+    }
+    for (int i = 0; i < bookings.slotCount(); i++) {
+        if (bookings.isLive(i) && !exported.storeBooking(bookings[i])) {
+            std::cout << "Error: Failed writing bookings to " << filename << std::endl;
+            return false;
         }
-        if (parseJsonStringFromObject(bookingObj, "cabinClass", tempStr, sizeof(tempStr))) {
-            booking.setCabinClass(tempStr);
+    }
+    exported.setNextBookingId(nextBookingId);
+    exported.sync();
+
+    std::cout << "Bookings saved successfully to " << filename << std::endl;
+    return true;
+}
+
+// Journal operations
+void BookingManager::setStoragePaths(const char* filename) {
+    if (!stringCompare(filename, snapshotPath) && binaryStore.isOpen()) {
+        binaryStore.close();
+    }
+    if (!stringCompare(filename, snapshotPath)) {
+        journalFile.close();
+    }
+    copyString(snapshotPath, filename, MAX_PATH_LENGTH);
+    useBinaryStore = isBinaryStorePath(filename);
+
+    // data/bookings.json -> data/bookings.journal
+    int len = stringLength(snapshotPath);
+    int extPos = len;
+    for (int i = len - 1; i >= 0 && snapshotPath[i] != '/' && snapshotPath[i] != '\\'; i--) {
+        if (snapshotPath[i] == '.') {
+            extPos = i;
+            break;
         }
-        if (parseJsonStringFromObject(bookingObj, "bookingStatus", tempStr, sizeof(tempStr))) {
-            booking.setBookingStatus(tempStr);
+    }
+    if (extPos > MAX_PATH_LENGTH - 9) extPos = MAX_PATH_LENGTH - 9;
+    copyString(journalPath, snapshotPath, extPos + 1);
+    copyString(journalPath + extPos, ".journal", 9);
+
+    // data/bookings.json -> data/bookings.ids, shared by both backends
+    char idPath[MAX_PATH_LENGTH];
+    copyString(idPath, journalPath, extPos + 1);
+    copyString(idPath + extPos, ".ids", 5);
+    idAllocator.setPath(idPath);
+}
+
+bool BookingManager::appendJournalRecord(const char* op, const Booking& booking) {
+    // One record per line so a torn write only ever loses the last record
+    std::ostringstream record;
+    record << std::setprecision(std::numeric_limits<double>::max_digits10);
+    record << "{\"op\": \"" << op << "\", \"bookingId\": " << booking.getBookingId();
+    if (!stringCompare(op, "cancel")) {
+        record << ", \"pnr\": " << JsonString(booking.getPnr())
+               << ", \"passengerName\": " << JsonString(booking.getPassengerName())
+               << ", \"flightNumber\": " << JsonString(booking.getFlightNumber())
+               << ", \"origin\": " << JsonString(booking.getOrigin())
+               << ", \"destination\": " << JsonString(booking.getDestination())
+               << ", \"departureDate\": " << JsonString(booking.getDepartureDate())
+               << ", \"departureTime\": " << JsonString(booking.getDepartureTime())
+               << ", \"seatNumber\": " << JsonString(booking.getSeatNumber())
+               << ", \"cabinClass\": " << JsonString(booking.getCabinClass())
+               << ", \"totalPrice\": " << booking.getTotalPrice()
+               << ", \"bookingStatus\": " << JsonString(booking.getBookingStatus())
+               << ", \"bookingDate\": " << JsonString(booking.getBookingDate())
+               << ", \"bookingTime\": " << JsonString(booking.getBookingTime());
+    }
+    record << "}\n";
+    return writeJournalRecord(record.str());
+}
+
+bool BookingManager::appendHoldRecord(const SeatHold& hold) {
+    char record[160];
+    snprintf(record, sizeof(record),
+             "{\"op\": \"hold\", \"holdId\": %llu, \"flightNumber\": \"%s\", \"seatNumber\": \"%s\", \"expiresAt\": %lld}\n",
+             static_cast<unsigned long long>(hold.holdId), hold.flightNumber, hold.seatNumber, hold.expiresAt);
+    return writeJournalRecord(record);
+}
+
+bool BookingManager::appendReleaseRecord(std::uint64_t holdId) {
+    char record[80];
+    snprintf(record, sizeof(record), "{\"op\": \"release\", \"holdId\": %llu}\n",
+             static_cast<unsigned long long>(holdId));
+    return writeJournalRecord(record);
+}
+
+bool BookingManager::openJournal() {
+    if (journalFile.isOpen()) return true;
+    if (!journalFile.open(journalPath)) {
+        std::cout << "Error: Cannot open journal for writing: " << journalPath << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool BookingManager::writeJournalRecord(const std::string& record) {
+    if (!openJournal()) {
+        return false;
+    }
+
+    // A record only counts as written once it is on disk
+    long long recordStart = 0;
+    int length = static_cast<int>(record.size());
+    if (!journalFile.append(record.data(), length, recordStart) || !journalFile.sync()) {
+        std::cout << "Error: Failed writing to journal: " << journalPath << std::endl;
+        return false;
+    }
+    // Skip our own record only if nothing from other processes is still unread before it
+    if (recordStart == journalOffset) {
+        journalOffset = recordStart + length;
+    }
+
+    // Live holds are carried into the new journal, so they never count towards the next checkpoint
+    journalRecordCount++;
+    if (journalRecordCount >= CHECKPOINT_INTERVAL + seatHolds.size() && journalRecordCount >= bookings.size()) {
+        checkpoint();
+    }
+    return true;
+}
+
+bool BookingManager::replayHoldRecord(const char* record) {
+    unsigned long long holdId;
+    char flightNumber[10];
+    char seatNumber[5];
+    long long expiresAt;
+    if (sscanf(record, "{\"op\": \"hold\", \"holdId\": %llu, \"flightNumber\": \"%9[^\"]\", \"seatNumber\": \"%4[^\"]\", \"expiresAt\": %lld}",
+               &holdId, flightNumber, seatNumber, &expiresAt) == 4) {
+        // Holds are placed under the lock, so a replayed one never conflicts
+        long long now = currentEpochSeconds();
+        if (expiresAt > now && !seatOccupancy.isOccupied(flightNumber, seatNumber)) {
+            seatHolds.place(holdId, flightNumber, seatNumber, expiresAt, now);
         }
-        if (parseJsonStringFromObject(bookingObj, "bookingDate", tempStr, sizeof(tempStr))) {
-            booking.setBookingDate(tempStr);
+        return true;
+    }
+    if (sscanf(record, "{\"op\": \"release\", \"holdId\": %llu}", &holdId) == 1) {
+        seatHolds.release(holdId);
+        return true;
+    }
+    return false;
+}
+
+long long BookingManager::currentEpochSeconds() {
+    return static_cast<long long>(time(nullptr));
+}
+
+int BookingManager::replayJournal(const char* filename, long long fromOffset, bool repairTail) {
+    std::ifstream journal(filename, std::ios::binary);
+    if (!journal.is_open()) {
+        return 0;
+    }
+    journal.seekg(fromOffset);
+    journalOffset = fromOffset;
+
+    int replayed = 0;
+    bool unterminatedTail = false;
+    char record[2000];
+    while (true) {
+        journal.getline(record, sizeof(record));
+        if (journal.bad() || (journal.fail() && journal.gcount() == 0)) break;
+        unterminatedTail = journal.eof();
+        if (journal.fail()) {
+            // Oversized line: skip it rather than misreading the rest of the journal
+            journal.clear();
+            journal.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+            if (!journal.eof()) journalOffset = journal.tellg();
+            continue;
         }
-        if (parseJsonStringFromObject(bookingObj, "bookingTime", tempStr, sizeof(tempStr))) {
-            booking.setBookingTime(tempStr);
+
+        // Without the lock an unterminated last line may still be being written
+        if (unterminatedTail && !repairTail) break;
+        if (!unterminatedTail) journalOffset = journal.tellg();
+
+        int generation;
+        if (sscanf(record, "{\"op\": \"checkpoint\", \"generation\": %d}", &generation) == 1) {
+            journalGeneration = generation;
+            continue;
+        }
+        if (replayHoldRecord(record)) {
+            replayed++;
+            continue;
         }
 
-        // Parse totalPrice
-        double price = parseJsonDoubleFromObject(bookingObj, "totalPrice");
-        if (price > 0.0) booking.setTotalPrice(price);
+        // A record that does not parse to a closed object is a torn write from a crash
+        JsonStreamReader reader(record, stringLength(record));
+        if (reader.next() != JsonStreamReader::BEGIN_OBJECT) continue;
 
-        // Add to bookings array
-        bookings[bookingCount] = booking;
-        bookingCount++;
+        Booking booking;
+        char op[20];
+        op[0] = '\0';
+        if (readBookingObject(reader, booking, op, sizeof(op))) {
+            applyJournalRecord(op, booking);
+            replayed++;
+        }
+    }
+    journal.close();
 
-        // Move to next booking
-        pos = objEnd + 1;
+    // Terminate a torn last line so the next append starts on a fresh line
+    long long repairStart = 0;
+    if (unterminatedTail && repairTail && openJournal() && journalFile.append("\n", 1, repairStart)) {
+        journalFile.sync();
+        journalOffset = repairStart + 1;
     }
+    return replayed;
+}
 
-    std::cout << "Loaded " << bookingCount << " bookings from " << filename << std::endl;
-    std::cout << "Next booking ID will be: " << nextBookingId << std::endl;
-    return true;
+int BookingManager::readJournalGeneration() {
+    // Journals written before the first checkpoint have no header
+    std::ifstream journal(journalPath, std::ios::binary);
+    char header[64];
+    int generation = 0;
+    if (journal.is_open() && journal.getline(header, sizeof(header))) {
+        sscanf(header, "{\"op\": \"checkpoint\", \"generation\": %d}", &generation);
+    }
+    return generation;
+}
+
+void BookingManager::applyJournalRecord(const char* op, const Booking& booking) {
+    int id = booking.getBookingId();
+    if (id <= 0) return;
+    if (id >= nextBookingId) nextBookingId = id + 1;
+
+    if (stringCompare(op, "cancel")) {
+        int slot = idIndex.findSlot(id);
+        if (slot >= 0) {
+            removeBookingAt(slot);
+        }
+        return;
+    }
+
+    // "create" and "update" both carry the full record, so replay is an upsert
+    Booking* existing = findBookingById(id);
+    if (existing) {
+        seatOccupancy.release(existing->getFlightNumber(), existing->getSeatNumber());
+        if (!stringCompare(existing->getFlightNumber(), booking.getFlightNumber())) {
+            flightIndex.remove(existing->getFlightNumber(), id);
+            flightIndex.add(booking.getFlightNumber(), id);
+        }
+        *existing = booking;
+        occupySeat(booking.getFlightNumber(), booking.getSeatNumber());
+    } else {
+        appendBooking(booking);
+    }
 }
 
 double BookingManager::calculateTotalRevenue() const {
     double totalRevenue = 0.0;
-    for (int i = 0; i < bookingCount; i++) {
+    for (int i = 0; i < bookings.slotCount(); i++) {
+        if (!bookings.isLive(i)) continue;
         if (stringCompare(bookings[i].getBookingStatus(), "confirmed") ||
             stringCompare(bookings[i].getBookingStatus(), "modified")) {
             totalRevenue += bookings[i].getTotalPrice();
@@ -527,18 +1185,72 @@ double BookingManager::calculateTotalRevenue() const {
 
 // Private helper methods implementation
 void BookingManager::generatePnr(char* pnr, int bookingId) {
-    // Generate a 6-character PNR based on booking ID and random letters
-    char letters[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZ";
-    pnr[0] = letters[rand() % 26];
-    pnr[1] = letters[rand() % 26];
+    // Unique per booking ID and computed without shared state
+    if (!pnrCodec.encode(bookingId, pnr)) {
+        std::cout << "Error: Booking ID " << bookingId << " is outside the PNR range." << std::endl;
+        pnr[0] = '\0';
+    }
+}
+
+bool BookingManager::isLegacyPnr(const Booking& booking) const {
+    return pnrCodec.decode(booking.getPnr()) != booking.getBookingId();
+}
 
-    // Add some digits based on booking ID
-    int id = bookingId % 10000;
-    pnr[2] = '0' + (id / 1000);
-    pnr[3] = '0' + ((id / 100) % 10);
-    pnr[4] = '0' + ((id / 10) % 10);
-    pnr[5] = '0' + (id % 10);
-    pnr[6] = '\0';
+void BookingManager::appendBooking(const Booking& booking) {
+    idIndex.setSlot(booking.getBookingId(), bookings.slotCount());
+    if (isLegacyPnr(booking)) {
+        pnrIndex.insert(booking.getPnr(), booking.getBookingId());
+    }
+    occupySeat(booking.getFlightNumber(), booking.getSeatNumber());
+    flightIndex.add(booking.getFlightNumber(), booking.getBookingId());
+    bookings.append(booking);
+    liveSlotsStale = true;
+}
+
+void BookingManager::occupySeat(const char* flightNumber, const char* seatNumber) {
+    // A booked seat needs no hold, so booking it consumes the hold in O(1)
+    seatOccupancy.occupy(flightNumber, seatNumber);
+    seatHolds.releaseSeat(flightNumber, seatNumber);
+}
+
+void BookingManager::removeBookingAt(int index) {
+    int bookingId = bookings[index].getBookingId();
+    if (isLegacyPnr(bookings[index])) {
+        pnrIndex.remove(bookings[index].getPnr(), bookingId);
+    }
+    idIndex.markCancelled(bookingId);
+    seatOccupancy.release(bookings[index].getFlightNumber(), bookings[index].getSeatNumber());
+    flightIndex.remove(bookings[index].getFlightNumber(), bookingId);
+
+    // The slot stays a hole, so every other booking keeps its index and address
+    bookings.removeAt(index);
+    liveSlotsStale = true;
+}
+
+void BookingManager::rebuildIndexes() {
+    int minId = 0, maxId = 0;
+    for (int i = 0; i < bookings.slotCount(); i++) {
+        if (!bookings.isLive(i)) continue;
+        int id = bookings[i].getBookingId();
+        if (minId == 0 || id < minId) minId = id;
+        if (id > maxId) maxId = id;
+    }
+    // Leave room for the IDs this session will hand out
+    if (nextBookingId > maxId) maxId = nextBookingId;
+
+    idIndex.reset(minId, maxId);
+    pnrIndex.clear();
+    seatOccupancy.clear();
+    flightIndex.clear();
+    for (int i = 0; i < bookings.slotCount(); i++) {
+        if (!bookings.isLive(i)) continue;
+        idIndex.setSlot(bookings[i].getBookingId(), i);
+        if (isLegacyPnr(bookings[i])) {
+            pnrIndex.insert(bookings[i].getPnr(), bookings[i].getBookingId());
+        }
+        seatOccupancy.occupy(bookings[i].getFlightNumber(), bookings[i].getSeatNumber());
+        flightIndex.add(bookings[i].getFlightNumber(), bookings[i].getBookingId());
+    }
 }
 
 void BookingManager::updateBookingStatus(int bookingId, const char* status) {
@@ -590,163 +1302,6 @@ void BookingManager::getCurrentDateTime(char* date, char* time) {
             timeInfo->tm_min);
 }
 
-// Custom JSON parsing functions without STL
-char* BookingManager::findStringInBuffer(const char* buffer, const char* searchStr) {
-    if (!buffer || !searchStr) return nullptr;
-
-    int searchLen = 0;
-    while (searchStr[searchLen]) searchLen++; // Calculate length
-
-    const char* pos = buffer;
-    while (*pos) {
-        bool match = true;
-        for (int i = 0; i < searchLen; i++) {
-            if (pos[i] != searchStr[i]) {
-                match = false;
-                break;
-            }
-        }
-        if (match) return const_cast<char*>(pos);
-        pos++;
-    }
-    return nullptr;
-}
-
-char* BookingManager::findCharInBuffer(const char* buffer, char ch) {
-    if (!buffer) return nullptr;
-
-    const char* pos = buffer;
-    while (*pos) {
-        if (*pos == ch) return const_cast<char*>(pos);
-        pos++;
-    }
-    return nullptr;
-}
-
-char* BookingManager::findMatchingBrace(const char* start) {
-    if (!start || *start != '{') return nullptr;
-
-    int braceCount = 1;
-    const char* pos = start + 1;
-
-    while (*pos && braceCount > 0) {
-        if (*pos == '{') braceCount++;
-        else if (*pos == '}') braceCount--;
-        if (braceCount == 0) return const_cast<char*>(pos);
-        pos++;
-    }
-    return nullptr;
-}
-
-int BookingManager::parseIntFromBuffer(const char* buffer) {
-    if (!buffer) return 0;
-
-    // Skip whitespace
-    while (*buffer == ' ' || *buffer == '\t' || *buffer == '\n') buffer++;
-
-    int result = 0;
-    bool negative = false;
-
-    if (*buffer == '-') {
-        negative = true;
-        buffer++;
-    }
-
-    while (*buffer >= '0' && *buffer <= '9') {
-        result = result * 10 + (*buffer - '0');
-        buffer++;
-    }
-
-    return negative ? -result : result;
-}
-
-double BookingManager::parseDoubleFromBuffer(const char* buffer) {
-    if (!buffer) return 0.0;
-
-    // Skip whitespace
-    while (*buffer == ' ' || *buffer == '\t' || *buffer == '\n') buffer++;
-
-    double result = 0.0;
-    double decimal = 0.0;
-    double decimalDiv = 1.0;
-    bool negative = false;
-    bool afterDecimal = false;
-
-    if (*buffer == '-') {
-        negative = true;
-        buffer++;
-    }
-
-    while ((*buffer >= '0' && *buffer <= '9') || *buffer == '.') {
-        if (*buffer == '.') {
-            afterDecimal = true;
-        } else if (afterDecimal) {
-            decimalDiv *= 10.0;
-            decimal = decimal * 10.0 + (*buffer - '0');
-        } else {
-            result = result * 10.0 + (*buffer - '0');
-        }
-        buffer++;
-    }
-
-    result += decimal / decimalDiv;
-    return negative ? -result : result;
-}
-
-void BookingManager::copyStringN(char* dest, const char* src, int n) {
-    for (int i = 0; i < n && src[i]; i++) {
-        dest[i] = src[i];
-    }
-}
-
-bool BookingManager::parseJsonStringFromObject(const char* json, const char* key, char* result, int maxLen) {
-    // Find key in JSON object
-    char searchKey[100];
-    sprintf(searchKey, "\"%s\":", key);
-
-    char* keyPos = findStringInBuffer(json, searchKey);
-    if (!keyPos) return false;
-
-    char* valueStart = findCharInBuffer(keyPos + stringLength(searchKey), '"');
-    if (!valueStart) return false;
-
-    valueStart++; // Skip opening quote
-    char* valueEnd = findCharInBuffer(valueStart, '"');
-    if (!valueEnd) return false;
-
-    int valueLength = valueEnd - valueStart;
-    if (valueLength >= maxLen) valueLength = maxLen - 1;
-
-    copyStringN(result, valueStart, valueLength);
-    result[valueLength] = '\0';
-
-    return true;
-}
-
-int BookingManager::parseJsonIntFromObject(const char* json, const char* key) {
-    // Find key in JSON object
-    char searchKey[100];
-    sprintf(searchKey, "\"%s\":", key);
-
-    char* keyPos = findStringInBuffer(json, searchKey);
-    if (!keyPos) return 0;
-
-    char* valueStart = keyPos + stringLength(searchKey);
-    return parseIntFromBuffer(valueStart);
-}
-
-double BookingManager::parseJsonDoubleFromObject(const char* json, const char* key) {
-    // Find key in JSON object
-    char searchKey[100];
-    sprintf(searchKey, "\"%s\":", key);
-
-    char* keyPos = findStringInBuffer(json, searchKey);
-    if (!keyPos) return 0.0;
-
-    char* valueStart = keyPos + stringLength(searchKey);
-    return parseDoubleFromBuffer(valueStart);
-}
-
 bool BookingManager::containsIgnoreCase(const char* str, const char* substr) {
     if (!str || !substr) return false;
 
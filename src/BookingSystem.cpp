@@ -1,5 +1,6 @@
 #include "BookingSystem.h"
 #include "StringUtils.h"
+#include "Date.h"
 #include <iostream>
 #include <fstream>
 #include <chrono>
@@ -9,134 +10,124 @@
 #include <ctime>
 #include <limits>
 #include <cstring>
+#include <cstdio>
 
-BookingSystem::BookingSystem() {
+BookingSystem::BookingSystem()
+    : bookingLock("data/bookings.lock"), flightLocks("data/locks"),
+      paymentProcessor(PAYMENT_LATENCY_MS, 0.0) {
     std::cout << "Attempting to load existing bookings..." << std::endl;
     if (!std::filesystem::exists("data")) {
         std::filesystem::create_directory("data");
         std::cout << "Created 'data' directory." << std::endl;
     }
-    bookingManager.loadBookingsFromFile("data/bookings.json");
+    std::filesystem::create_directories("data/locks");
+    bookingManager.setStorageLock(&bookingLock);
+
+    // Use the memory-mapped binary store when it exists or is requested;
+    // requesting it for the first time imports the JSON bookings.
+    const char* storeSetting = std::getenv("AIRPLANE_BOOKING_STORE");
+    bool binaryRequested = storeSetting && stringCompare(storeSetting, "binary");
+    if (std::filesystem::exists("data/bookings.bin")) {
+        bookingManager.loadBookingsFromFile("data/bookings.bin");
+    } else if (binaryRequested) {
+        bookingManager.loadBookingsFromFile("data/bookings.json");
+        bookingManager.saveBookingsToFile("data/bookings.bin");
+        bookingManager.loadBookingsFromFile("data/bookings.bin");
+    } else {
+        bookingManager.loadBookingsFromFile("data/bookings.json");
+    }
     flightList.loadFlightsFromFile("data/flights.json");
+    pricingEngine.loadFromFile("data/pricing.json");
+    itineraryPlanner.build(flightList, pricingEngine);
+
+    // Simulated payment processor settings, e.g. for load tests
+    const char* latencySetting = std::getenv("AIRPLANE_PAYMENT_LATENCY_MS");
+    if (latencySetting) {
+        paymentProcessor.setLatency(std::atoi(latencySetting));
+    }
+    const char* failureSetting = std::getenv("AIRPLANE_PAYMENT_FAILURE_RATE");
+    if (failureSetting) {
+        paymentProcessor.setFailureRate(std::atof(failureSetting));
+    }
     std::cout << "Booking system initialized." << std::endl;
     selectedFlightIndex = -1;
+    selectedFlightVersion = 0;
+    chargedAmount = 0.0;
+    paymentTransactionId[0] = '\0';
 }
 
 BookingSystem::~BookingSystem() {}
 
 void BookingSystem::acquireLock() {
-    bool acquired = false;
-    while (!acquired) {
-        try {
-            // Attempt to create the lock file. O_CREAT | O_EXCL ensures it's atomic.
-            // On Windows, this is more complex. A simple approach is to check existence and then create.
-            if (!std::filesystem::exists("data/lock.txt")) {
-                std::ofstream lockFile("data/lock.txt");
-                if (lockFile.is_open()) {
-                    lockFile << std::this_thread::get_id();
-                    lockFile.close();
-                    acquired = true;
-                }
-            }
-        } catch (...) {
-            // File system errors, assume another process has the lock
-        }
-        if (!acquired) {
-            std::cout << "Thread " << std::this_thread::get_id() << " is waiting for the lock..." << std::endl;
-            std::this_thread::sleep_for(std::chrono::milliseconds(200));
-        }
+    // Blocks in the kernel until the current holder releases the lock
+    if (!bookingLock.lock()) {
+        std::cout << "Thread " << std::this_thread::get_id() << " could not acquire the lock." << std::endl;
+        return;
     }
-    std::cout << "Thread " << std::this_thread::get_id() << " has acquired the lock." << std::endl;
+    std::cout << "Thread " << std::this_thread::get_id() << " has acquired the lock (waited "
+              << (bookingLock.getLastWaitMicros() / 1000.0) << " ms)." << std::endl;
 }
 
 void BookingSystem::releaseLock() {
-    try {
-        if (std::filesystem::exists("data/lock.txt")) {
-            std::filesystem::remove("data/lock.txt");
-            std::cout << "Thread " << std::this_thread::get_id() << " has released the lock." << std::endl;
-        }
-    } catch (...) {
-        // Handle potential file removal errors
+    if (bookingLock.unlock()) {
+        std::cout << "Thread " << std::this_thread::get_id() << " has released the lock." << std::endl;
     }
 }
-double BookingSystem::calculateDynamicPrice(const Flight* flight, int daysUntilDeparture) {
-    if (!flight) return 0.0;
 
-    double basePrice = flight->getBasePrice();
-    double finalPrice = basePrice;
-
-    // Demand-based pricing (seats left)
-    int totalSeats = flight->getTotalSeats();
-    int availableSeats = flight->getAvailableSeats();
-    double occupancyRate = (double)(totalSeats - availableSeats) / totalSeats;
-
-    // Surge pricing based on demand
-    if (occupancyRate >= 0.9) {
-        finalPrice += basePrice * 0.50; // 50% surge
-    } else if (occupancyRate >= 0.8) {
-        finalPrice += basePrice * 0.35; // 35% surge
-    } else if (occupancyRate >= 0.7) {
-        finalPrice += basePrice * 0.25; // 25% surge
-    } else if (occupancyRate >= 0.6) {
-        finalPrice += basePrice * 0.15; // 15% surge
-    } else if (occupancyRate >= 0.5) {
-        finalPrice += basePrice * 0.10; // 10% surge
+void BookingSystem::acquireFlightLock(const char* flightNumber) {
+    FileLock& lock = flightLocks.forFlight(flightNumber);
+    if (!lock.lock()) {
+        std::cout << "Thread " << std::this_thread::get_id() << " could not lock flight " << flightNumber << "." << std::endl;
+        return;
     }
+    std::cout << "Thread " << std::this_thread::get_id() << " has locked flight " << flightNumber
+              << " (stripe " << LockStripes::stripeFor(flightNumber) << ", waited "
+              << (lock.getLastWaitMicros() / 1000.0) << " ms)." << std::endl;
+}
 
-    // Time-based pricing (days until departure)
-    if (daysUntilDeparture <= 1) {
-        finalPrice += basePrice * 0.75; // 75% increase for last-minute booking
-    } else if (daysUntilDeparture <= 3) {
-        finalPrice += basePrice * 0.50; // 50% increase
-    } else if (daysUntilDeparture <= 7) {
-        finalPrice += basePrice * 0.30; // 30% increase
-    } else if (daysUntilDeparture <= 14) {
-        finalPrice += basePrice * 0.20; // 20% increase
-    } else if (daysUntilDeparture <= 21) {
-        finalPrice += basePrice * 0.10; // 10% increase
-    } else if (daysUntilDeparture <= 30) {
-        finalPrice += basePrice * 0.05; // 5% increase
+void BookingSystem::releaseFlightLock(const char* flightNumber) {
+    if (flightLocks.forFlight(flightNumber).unlock()) {
+        std::cout << "Thread " << std::this_thread::get_id() << " has unlocked flight " << flightNumber << "." << std::endl;
     }
-    // No increase for bookings more than 30 days in advance
+}
+
+bool BookingSystem::lockFlightOfBooking(int bookingId, char* flightNumber) {
+    const Booking* booking = bookingManager.getBookingById(bookingId);
+    if (!booking) return false;
+    copyString(flightNumber, booking->getFlightNumber(), 10);
 
-    return finalPrice;
+    acquireFlightLock(flightNumber);
+
+    // Refresh now that no one else can change this flight's bookings
+    bookingManager.reloadBookings();
+    booking = bookingManager.getBookingById(bookingId);
+    if (!booking || !stringCompare(booking->getFlightNumber(), flightNumber)) {
+        releaseFlightLock(flightNumber);
+        return false;
+    }
+    return true;
 }
 
 void BookingSystem::showDynamicPricingBreakdown(const Flight* flight, int daysUntilDeparture) {
     if (!flight) return;
 
-    double basePrice = flight->getBasePrice();
-    double dynamicPrice = calculateDynamicPrice(flight, daysUntilDeparture);
+    const PriceQuote& price = flight->getPriceQuote(pricingEngine, daysUntilDeparture);
 
     int totalSeats = flight->getTotalSeats();
     int availableSeats = flight->getAvailableSeats();
     double occupancyRate = (double)(totalSeats - availableSeats) / totalSeats;
 
     std::cout << "\n=== DYNAMIC PRICING BREAKDOWN ===" << std::endl;
-    std::cout << "Base Fare: $" << basePrice << std::endl;
+    std::cout << "Base Fare: $" << price.baseFare << std::endl;
     std::cout << "Occupancy Rate: " << (occupancyRate * 100) << "%" << std::endl;
     std::cout << "Days Until Departure: " << daysUntilDeparture << " days" << std::endl;
-
-    double demandSurge = 0.0;
-    if (occupancyRate >= 0.9) demandSurge = basePrice * 0.50;
-    else if (occupancyRate >= 0.8) demandSurge = basePrice * 0.35;
-    else if (occupancyRate >= 0.7) demandSurge = basePrice * 0.25;
-    else if (occupancyRate >= 0.6) demandSurge = basePrice * 0.15;
-    else if (occupancyRate >= 0.5) demandSurge = basePrice * 0.10;
-
-    double timeSurge = 0.0;
-    if (daysUntilDeparture <= 1) timeSurge = basePrice * 0.75;
-    else if (daysUntilDeparture <= 3) timeSurge = basePrice * 0.50;
-    else if (daysUntilDeparture <= 7) timeSurge = basePrice * 0.30;
-    else if (daysUntilDeparture <= 14) timeSurge = basePrice * 0.20;
-    else if (daysUntilDeparture <= 21) timeSurge = basePrice * 0.10;
-    else if (daysUntilDeparture <= 30) timeSurge = basePrice * 0.05;
-
-    std::cout << "Demand Surge: $" << demandSurge << std::endl;
-    std::cout << "Time-based Surge: $" << timeSurge << std::endl;
-    std::cout << "Taxes & Fees: $45.50" << std::endl;
+    std::cout << "Demand Surge: $" << price.demandSurge << std::endl;
+    std::cout << "Time-based Surge: $" << price.timeSurge << std::endl;
+    char taxes[32];
+    snprintf(taxes, sizeof(taxes), "%.2f", price.taxes);
+    std::cout << "Taxes & Fees: $" << taxes << std::endl;
     std::cout << "--------------------------------" << std::endl;
-    std::cout << "Final Price: $" << (dynamicPrice + 45.50) << std::endl;
+    std::cout << "Final Price: $" << price.total << std::endl;
     std::cout << "==================================" << std::endl;
 }
 
@@ -152,7 +143,7 @@ void BookingSystem::searchFlights() {
     bool found = searchFlightsByRoute();
     if (found) {
         displayFlightOptions();
-    } else {
+    } else if (!displayConnectingItineraries()) {
         std::cout << "No flights found matching your criteria." << std::endl;
     }
 }
@@ -166,7 +157,7 @@ bool BookingSystem::searchFlightsByRoute() {
     const char* departureDate = userInput.getDepartureDate();
 
     // Search using FlightList
-    int foundCount = flightList.searchByRoute(origin, destination, departureDate);
+    int foundCount = flightList.searchByRoute(origin, destination, departureDate, routeMatches);
 
     if (foundCount > 0) {
         std::cout << "Found " << foundCount << " flights matching your criteria." << std::endl;
@@ -180,35 +171,97 @@ bool BookingSystem::searchFlightsByRoute() {
 void BookingSystem::displayFlightOptions() {
     std::cout << "\n=== AVAILABLE FLIGHTS ===" << std::endl;
 
-    int flightCount = flightList.getFlightCount();
-    if (flightCount == 0) {
+    int matchCount = static_cast<int>(routeMatches.size());
+    if (matchCount == 0) {
         std::cout << "No flights available to display." << std::endl;
         return;
     }
 
-    for (int i = 0; i < flightCount; i++) {
-        const Flight* flight = flightList.getFlightByIndex(i);
+    for (int i = 0; i < matchCount; i++) {
+        const Flight* flight = flightList.getFlightByIndex(routeMatches[i]);
         if (flight && flight->isAvailable()) {
             std::cout << "\n--- Flight " << (i + 1) << " ---" << std::endl;
             flight->displayFlightInfo();
 
-            // Show dynamic pricing
-            int daysUntilDeparture = 15; // Default for demo
-            double dynamicPrice = calculateDynamicPrice(flight, daysUntilDeparture);
-            std::cout << "Current Price: $" << (dynamicPrice + 45.50) << " (including taxes)" << std::endl;
+            // Show dynamic pricing; repeat views reuse the flight's cached quote
+            int daysUntilDeparture = Date::daysUntil(flight->getDepartureDay());
+            double price = flight->getPriceQuote(pricingEngine, daysUntilDeparture).total;
+            std::cout << "Current Price: $" << price << " (including taxes)" << std::endl;
         }
     }
     std::cout << "=========================" << std::endl;
 }
 
+static void printDuration(int minutes) {
+    std::cout << (minutes / 60) << "h " << (minutes % 60) << "m";
+}
+
+bool BookingSystem::displayConnectingItineraries() {
+    // Built at catalog load; rebuilt only after the catalog or its fares changed
+    itineraryPlanner.refresh(flightList, pricingEngine);
+
+    const char* origin = userInput.getOrigin();
+    const char* destination = userInput.getDestination();
+    const char* departureDate = userInput.getDepartureDate();
+    std::vector<Itinerary> itineraries;
+    int found = itineraryPlanner.findItineraries(origin, destination, departureDate, Itinerary::MAX_LEGS,
+                                                 ItineraryPlanner::BY_DURATION, MAX_CONNECTING_OPTIONS, itineraries);
+    if (found == 0) {
+        return false;
+    }
+
+    std::cout << "Connecting flights are available." << std::endl;
+    std::cout << "Sort by (1) total travel time or (2) fare: ";
+    int choice;
+    std::cin >> choice;
+    std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+    if (choice == 2) {
+        found = itineraryPlanner.findItineraries(origin, destination, departureDate, Itinerary::MAX_LEGS,
+                                                 ItineraryPlanner::BY_FARE, MAX_CONNECTING_OPTIONS, itineraries);
+    }
+
+    std::cout << "\n=== CONNECTING ITINERARIES ===" << std::endl;
+    for (int i = 0; i < found; i++) {
+        const Itinerary& itinerary = itineraries[i];
+        int stops = itinerary.legCount - 1;
+        char fare[32];
+        snprintf(fare, sizeof(fare), "%.2f", itinerary.fare);
+
+        std::cout << "\n--- Option " << (i + 1) << ": " << stops << (stops == 1 ? " stop" : " stops") << ", ";
+        printDuration(itinerary.getDurationMinutes());
+        std::cout << ", $" << fare << " per traveler (including taxes) ---" << std::endl;
+
+        const Flight* previous = nullptr;
+        for (int leg = 0; leg < itinerary.legCount; leg++) {
+            const Flight* flight = flightList.getFlightByIndex(itinerary.flightIndex[leg]);
+            if (!flight) continue;
+            if (previous) {
+                int landed = Date::parse(previous->getArrivalDate()) * 24 * 60 +
+                             Date::parseTimeOfDay(previous->getArrivalTime());
+                int leaves = flight->getDepartureDay() * 24 * 60 + Date::parseTimeOfDay(flight->getDepartureTime());
+                std::cout << "  Layover in " << flight->getOrigin() << ": ";
+                printDuration(leaves - landed);
+                std::cout << std::endl;
+            }
+            std::cout << "  " << flight->getFlightNumber() << " (" << flight->getAirlineName() << ") "
+                      << flight->getOrigin() << " " << flight->getDepartureDate() << " " << flight->getDepartureTime()
+                      << " -> " << flight->getDestination() << " " << flight->getArrivalDate() << " "
+                      << flight->getArrivalTime() << std::endl;
+            previous = flight;
+        }
+    }
+    std::cout << "==============================" << std::endl;
+    return true;
+}
+
 int BookingSystem::selectFlightFromList() {
-    int flightCount = flightList.getFlightCount();
-    if (flightCount == 0) {
+    int matchCount = static_cast<int>(routeMatches.size());
+    if (matchCount == 0) {
         std::cout << "No flights available for selection." << std::endl;
         return -1;
     }
 
-    std::cout << "\nSelect a flight (1-" << flightCount << ", or 0 to cancel): ";
+    std::cout << "\nSelect a flight (1-" << matchCount << ", or 0 to cancel): ";
     int choice;
     std::cin >> choice;
     std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
@@ -218,12 +271,12 @@ int BookingSystem::selectFlightFromList() {
         return -1;
     }
 
-    if (choice < 1 || choice > flightCount) {
+    if (choice < 1 || choice > matchCount) {
         std::cout << "Invalid selection. Please try again." << std::endl;
         return selectFlightFromList(); // Recursive call for retry
     }
 
-    int selectedIndex = choice - 1;
+    int selectedIndex = routeMatches[choice - 1];
     const Flight* selectedFlight = flightList.getFlightByIndex(selectedIndex);
 
     if (selectedFlight && selectedFlight->isAvailable()) {
@@ -257,8 +310,8 @@ bool BookingSystem::selectPassengerSeats(const Flight* flight) {
         return false;
     }
 
-    // Load the latest booking data to ensure the seat map is up to date
-    bookingManager.loadBookingsFromFile("data/bookings.json");
+    // Pick up bookings appended since the last read; no lock is taken
+    bookingManager.refreshBookings();
 
     int passengerCount = userInput.getTravelers();
     std::cout << "\n=== SEAT SELECTION ===" << std::endl;
@@ -273,13 +326,20 @@ bool BookingSystem::selectPassengerSeats(const Flight* flight) {
             std::cin.getline(seatNumber, 5);
 
             if (isValidSeatNumber(seatNumber)) {
-                // Check if the seat is already occupied
-                if (isSeatOccupied(seatNumber, *flight)) {
+                // Check if the seat is already occupied, including by an earlier passenger's hold
+                // Each passenger's seat gets its own hold through checkout
+                std::uint64_t hold = 0;
+                if (!isSeatOccupied(seatNumber, *flight, 0)) {
+                    hold = bookingManager.placeSeatHold(flight->getFlightNumber(), seatNumber, SEAT_HOLD_SECONDS, 0);
+                }
+                if (hold == 0) {
                     std::cout << "Seat " << seatNumber << " is already taken. Please choose another seat." << std::endl;
                     // Display the seat map again to help the user choose a new seat
                     showSeatMap(*flight);
                 } else {
+                    seatHoldIds.push_back(hold);
                     std::cout << "Seat " << seatNumber << " selected for passenger " << (i + 1) << std::endl;
+                    std::cout << "The seat is held for you for " << SEAT_HOLD_SECONDS / 60 << " minutes." << std::endl;
                     copyString(this->seatNumber, seatNumber, sizeof(this->seatNumber));
                     seatSelected = true; // Exit the loop for this passenger
                 }
@@ -359,9 +419,8 @@ void BookingSystem::reviewBookingDetails() {
     std::cout << "Departure Date: " << userInput.getDepartureDate() << std::endl;
 
     // Calculate and display total price
-    int daysUntilDeparture = 15;
-    double basePrice = calculateDynamicPrice(selectedFlight, daysUntilDeparture);
-    double totalPrice = (basePrice + 45.50) * userInput.getTravelers();
+    int daysUntilDeparture = Date::daysUntil(selectedFlight->getDepartureDay());
+    double totalPrice = selectedFlight->getPriceQuote(pricingEngine, daysUntilDeparture).total * userInput.getTravelers();
 
     std::cout << "Total Price: $" << totalPrice << std::endl;
 
@@ -403,9 +462,8 @@ bool BookingSystem::processPayment() {
     const Flight* flight = flightList.getFlightByIndex(selectedFlightIndex);
     if (!flight) return false;
 
-    int daysUntilDeparture = 15;
-    double basePrice = calculateDynamicPrice(flight, daysUntilDeparture);
-    double totalAmount = (basePrice + 45.50) * userInput.getTravelers();
+    int daysUntilDeparture = Date::daysUntil(flight->getDepartureDay());
+    double totalAmount = flight->getPriceQuote(pricingEngine, daysUntilDeparture).total * userInput.getTravelers();
 
     std::cout << "Total Amount: $" << totalAmount << std::endl;
     std::cout << "Payment Methods:" << std::endl;
@@ -423,56 +481,106 @@ bool BookingSystem::processPayment() {
         return false;
     }
 
+    PaymentRequest request;
+    request.amount = totalAmount;
+    request.method = paymentChoice;
+    copyString(request.reference, passengerName, sizeof(request.reference));
+
     std::cout << "Processing payment..." << std::endl;
+    std::future<PaymentResult> pending = paymentProcessor.submit(request);
 
-    // Simulate payment processing
-    std::this_thread::sleep_for(std::chrono::seconds(2));
+    // Catch up with other processes' bookings while the processor works,
+    // so the commit step has less journal to replay under the lock
+    bookingManager.refreshBookings();
+
+    PaymentResult result = pending.get();
+    if (!result.approved) {
+        std::cout << "Payment failed: " << result.message << std::endl;
+        return false;
+    }
 
     std::cout << "Payment processed successfully!" << std::endl;
-    std::cout << "Transaction ID: TXN" << (rand() % 1000000 + 100000) << std::endl;
+    std::cout << "Transaction ID: " << result.transactionId << std::endl;
+    chargedAmount = totalAmount;
+    copyString(paymentTransactionId, result.transactionId, sizeof(paymentTransactionId));
 
     return true;
 }
 
+void BookingSystem::refundPayment() {
+    std::cout << "Refunding $" << chargedAmount << " (transaction " << paymentTransactionId << ")..." << std::endl;
+    PaymentResult result = paymentProcessor.refund(paymentTransactionId, chargedAmount).get();
+    if (result.approved) {
+        std::cout << "Refund processed successfully." << std::endl;
+    } else {
+        std::cout << "Refund failed: " << result.message << ". Please contact support." << std::endl;
+    }
+    paymentTransactionId[0] = '\0';
+}
+
 bool BookingSystem::generateBookingConfirmation() {
-    acquireLock(); // Acquire lock at the start of the critical section
+    const Flight* chosenFlight = flightList.getFlightByIndex(selectedFlightIndex);
+    if (!chosenFlight) {
+        std::cout << "Failed to find the selected flight. Booking cancelled." << std::endl;
+        return false;
+    }
+    char flightNumber[10];
+    copyString(flightNumber, chosenFlight->getFlightNumber(), 10);
+
+    // Flight lock first, then the short global lock for the shared files
+    acquireFlightLock(flightNumber);
+    acquireLock();
 
-    const Flight* selectedFlight = nullptr;
     try {
-        // Reload fresh data to ensure we're not using stale information
-        bookingManager.loadBookingsFromFile("data/bookings.json");
+        // Only the commit step reads under the lock: the catalog is re-read for
+        // the seat count update and the bookings are caught up from the journal
         flightList.loadFlightsFromFile("data/flights.json");
+        bookingManager.reloadBookings();
 
-        selectedFlight = flightList.getFlightByIndex(selectedFlightIndex);
-        if (!selectedFlight) {
+        Flight* flightToUpdate = flightList.getFlightByNumber(flightNumber);
+        if (!flightToUpdate) {
             std::cout << "Failed to find the selected flight. Booking cancelled." << std::endl;
-            releaseLock(); // Release lock on failure
-            return false;
-        }
-
-        // Final check to see if the seat is still available
-        if (isSeatOccupied(seatNumber, *selectedFlight)) {
-            std::cout << "\nBooking failed: The selected seat " << seatNumber << " has been taken by another user." << std::endl;
             releaseLock();
+            releaseFlightLock(flightNumber);
             return false;
         }
 
-        // ... (rest of the booking logic) ...
-
-        // Get a non-const reference to the flight object to modify its properties
-        Flight* flightToUpdate = const_cast<Flight*>(selectedFlight);
+        // The customer has already been charged, so the booking keeps that fare
+        // even if the flight has been repriced since the quote
+        double totalPrice = chargedAmount;
+
+        // A live hold guarantees the seat, so only the price can have moved. Without one
+        // the seat is re-validated against the state just loaded under the lock.
+        // The booking is for the last passenger's seat, the one in seatNumber
+        std::uint64_t bookedSeatHold = seatHoldIds.empty() ? 0 : seatHoldIds.back();
+        bool seatHeld = bookingManager.isSeatHoldActive(bookedSeatHold);
+        if (!seatHeld || flightToUpdate->getVersion() != selectedFlightVersion) {
+            if (!seatHeld) {
+                std::cout << "\nThe hold on seat " << seatNumber << " has expired. Re-checking seat and price..." << std::endl;
+            } else {
+                std::cout << "\nFlight " << flightNumber << " changed since it was selected. Re-checking price..." << std::endl;
+            }
 
-        // Calculate final price
-        int daysUntilDeparture = 15;
-        double basePrice = calculateDynamicPrice(selectedFlight, daysUntilDeparture);
-        double totalPrice = (basePrice + 45.50) * userInput.getTravelers();
+            if (!seatHeld && isSeatOccupied(seatNumber, *flightToUpdate, bookedSeatHold)) {
+                std::cout << "\nBooking failed: The selected seat " << seatNumber << " has been taken by another user." << std::endl;
+                releaseLock();
+                releaseFlightLock(flightNumber);
+                return false;
+            }
+            int daysUntilDeparture = Date::daysUntil(flightToUpdate->getDepartureDay());
+            double currentPrice = flightToUpdate->getPriceQuote(pricingEngine, daysUntilDeparture).total * userInput.getTravelers();
+            std::cout << "Seat " << seatNumber << " is still yours. Total price: $" << totalPrice << std::endl;
+            if (currentPrice != totalPrice) {
+                std::cout << "(The current fare is $" << currentPrice
+                          << "; your booking keeps the fare you were charged.)" << std::endl;
+            }
+        }
 
         // Create booking in the BookingManager
         int bookingId = bookingManager.createBooking(
             passengerName,
             flightToUpdate->getFlightNumber(),
             userInput.getOrigin(),
-            // CORRECTED LINES BELOW
             userInput.getDestination(),
             userInput.getDepartureDate(),
             flightToUpdate->getDepartureTime(),
@@ -482,10 +590,11 @@ bool BookingSystem::generateBookingConfirmation() {
         );
 
         if (bookingId != -1) {
-            // Update the available seat count for the booked flight.
+            // Update the available seat count and publish a new inventory version
             int currentAvailableSeats = flightToUpdate->getAvailableSeats();
             int newAvailableSeats = currentAvailableSeats - userInput.getTravelers();
             flightToUpdate->setAvailableSeats(newAvailableSeats);
+            flightToUpdate->bumpVersion();
 
             std::cout << "\n=== BOOKING CONFIRMATION ===" << std::endl;
             std::cout << "Dear " << passengerName << "," << std::endl;
@@ -493,12 +602,13 @@ bool BookingSystem::generateBookingConfirmation() {
 
             bookingManager.displayBookingDetails(bookingId);
 
-            // Save the updated bookings and flight list to files
-            bookingManager.saveBookingsToFile("data/bookings.json");
+            // The booking is already journaled by createBooking; only the flight list needs saving
             flightList.saveFlightsToFile("data/flights.json");
 
             std::cout << "\nConfirmation sent to: " << passengerEmail << std::endl;
             std::cout << "SMS notification sent to: " << passengerPhone << std::endl;
+            releaseLock();
+            releaseFlightLock(flightNumber);
             return true;
         }
 
@@ -507,6 +617,7 @@ bool BookingSystem::generateBookingConfirmation() {
     }
 
     releaseLock(); // Release lock at the end
+    releaseFlightLock(flightNumber);
     return false;
 }
 int BookingSystem::getBookingIdFromInput(const char* input) {
@@ -535,51 +646,17 @@ int BookingSystem::getBookingIdFromInput(const char* input) {
 }
 
 void BookingSystem::showSeatMap(const Flight& flight) {
-    char seatMap[11][7]; // 10 rows, 6 columns + null terminator
-
-    // Initialize seat map with available seats
-    for (int i = 0; i < 10; ++i) {
-        for (int j = 0; j < 6; ++j) {
-            seatMap[i][j] = 'O';
-        }
-    }
-
-    // Load fresh data before displaying
-    bookingManager.loadBookingsFromFile("data/bookings.json");
-
-    // Mark occupied seats based on bookings
-    int bookingCount = bookingManager.getBookingCount();
-    for (int i = 0; i < bookingCount; ++i) {
-        // Use the new public getter method
-        const Booking* booking = bookingManager.getBooking(i);
-        if (booking && stringCompare(booking->getFlightNumber(), flight.getFlightNumber())) {
-            const char* seatNumber = booking->getSeatNumber();
-            int row = 0;
-            char column = '\0';
-
-            // Parse seat number string (e.g., "10A")
-            if (strlen(seatNumber) == 3) {
-                row = (seatNumber[0] - '0') * 10 + (seatNumber[1] - '0');
-                column = seatNumber[2];
-            } else if (strlen(seatNumber) == 2) {
-                row = seatNumber[0] - '0';
-                column = seatNumber[1];
-            }
-
-            if (row >= 1 && row <= 10 && column >= 'A' && column <= 'F') {
-                int colIndex = column - 'A';
-                int rowIndex = row - 1;
-                seatMap[rowIndex][colIndex] = 'X';
-            }
-        }
-    }
+    const char* flightNumber = flight.getFlightNumber();
 
     std::cout << "\n=== DYNAMIC SEAT MAP ===" << std::endl;
     std::cout << "        A B C   D E F" << std::endl;
     for (int i = 0; i < 10; ++i) {
         printf("%-2d  ", i + 1); // Print row number with spacing
         for (int j = 0; j < 6; ++j) {
-            std::cout << " " << seatMap[i][j];
+            std::uint64_t holder = bookingManager.getSeatHolder(flightNumber, i + 1, j);
+            // Seats held for earlier passengers of this booking are taken too
+            bool taken = bookingManager.isSeatOccupied(flightNumber, i + 1, j) || holder != 0;
+            std::cout << " " << (taken ? 'X' : 'O');
             if (j == 2) { // Add aisle
                 std::cout << "  ";
             }
@@ -587,6 +664,7 @@ void BookingSystem::showSeatMap(const Flight& flight) {
         std::cout << std::endl;
     }
     std::cout << "\nLegend: O = Available, X = Occupied" << std::endl;
+    std::cout << "Occupied seats on this flight: " << bookingManager.getOccupiedSeatCount(flightNumber) << std::endl;
     std::cout << "========================" << std::endl;
 }
 bool BookingSystem::isValidSeatNumber(const char* seatNumber) {
@@ -620,7 +698,12 @@ void BookingSystem::startBookingProcess() {
     bool found = searchFlightsByRoute();
 
     if (!found) {
-        std::cout << "No flights found for the specified criteria." << std::endl;
+        if (displayConnectingItineraries()) {
+            std::cout << "\nConnecting itineraries are booked one flight at a time; "
+                      << "start a new booking for each leg." << std::endl;
+        } else {
+            std::cout << "No flights found for the specified criteria." << std::endl;
+        }
         return;
     }
 
@@ -638,9 +721,9 @@ void BookingSystem::startBookingProcess() {
         std::cout << "Invalid flight selection. Booking cancelled." << std::endl;
         return;
     }
+    selectedFlightVersion = selectedFlight->getVersion();
 
-    // Calculate days until departure (simplified for demo)
-    int daysUntilDeparture = 15;
+    int daysUntilDeparture = Date::daysUntil(selectedFlight->getDepartureDay());
 
     std::cout << "\nStep 4: Dynamic pricing calculation..." << std::endl;
     showDynamicPricingBreakdown(selectedFlight, daysUntilDeparture);
@@ -659,30 +742,37 @@ void BookingSystem::startBookingProcess() {
     std::cout << "\nStep 7: Review booking details..." << std::endl;
     reviewBookingDetails();
 
-    if (validateBookingData()) {
-        processPayment();
-        generateBookingConfirmation(); // This function will now handle the lock
-    } else {
+    // Only a confirmed payment turns the seat hold into a booking
+    if (!validateBookingData()) {
         std::cout << "Booking validation failed. Please try again." << std::endl;
+    } else if (!processPayment()) {
+        std::cout << "Payment was not completed. Booking cancelled." << std::endl;
+    } else if (generateBookingConfirmation()) {
+        paymentProcessor.settle(paymentTransactionId);
+    } else {
+        // Charged but not booked: give the money back
+        refundPayment();
     }
+
+    // Booked, lapsed or abandoned: either way the holds are no longer needed
+    releaseSeatHolds();
 }// Enhanced Modification Functions
 void BookingSystem::changeFlightDate() {
     std::cout << "Enter Booking ID or PNR: ";
     char input[20];
     std::cin.getline(input, 20);
 
-    acquireLock();
-
-    try {
-        bookingManager.loadBookingsFromFile("data/bookings.json");
+    // Resolve the booking from a lock-free refresh; writers re-check under the flight lock
+    bookingManager.refreshBookings();
 
-        int bookingId = getBookingIdFromInput(input);
-        if (bookingId == -1) {
-            std::cout << "Booking not found." << std::endl;
-            releaseLock();
-            return;
-        }
+    int bookingId = getBookingIdFromInput(input);
+    char flightNumber[10];
+    if (bookingId == -1 || !lockFlightOfBooking(bookingId, flightNumber)) {
+        std::cout << "Booking not found." << std::endl;
+        return;
+    }
 
+    try {
         std::cout << "\n=== CHANGE FLIGHT DATE ===" << std::endl;
         std::cout << "Current booking details:" << std::endl;
         bookingManager.displayBookingDetails(bookingId);
@@ -705,14 +795,17 @@ void BookingSystem::changeFlightDate() {
 
         if (confirm == 'y' || confirm == 'Y') {
             // Update booking date and add fee
-            std::cout << "Flight date changed successfully!" << std::endl;
-            std::cout << "Date change fee of $" << changeFee << " will be charged." << std::endl;
-            bookingManager.saveBookingsToFile("data/bookings.json");
+            if (bookingManager.modifyDepartureDate(bookingId, newDate)) {
+                std::cout << "Flight date changed successfully!" << std::endl;
+                std::cout << "Date change fee of $" << changeFee << " will be charged." << std::endl;
+            } else {
+                std::cout << "Error: Could not save the date change." << std::endl;
+            }
         }
 
-        releaseLock();
+        releaseFlightLock(flightNumber);
     } catch (...) {
-        releaseLock();
+        releaseFlightLock(flightNumber);
         std::cout << "Error processing date change." << std::endl;
     }
 }
@@ -722,64 +815,38 @@ void BookingSystem::changeSeatSelection() {
     char input[20];
     std::cin.getline(input, 20);
 
-    acquireLock();
-
-    try {
-        bookingManager.loadBookingsFromFile("data/bookings.json");
+    // Resolve the booking from a lock-free refresh; writers re-check under the flight lock
+    bookingManager.refreshBookings();
 
-        int bookingId = getBookingIdFromInput(input);
-        if (bookingId == -1) {
-            std::cout << "Booking not found." << std::endl;
-            releaseLock();
-            return;
-        }
+    int bookingId = getBookingIdFromInput(input);
+    char flightNumber[10];
+    if (bookingId == -1 || !lockFlightOfBooking(bookingId, flightNumber)) {
+        std::cout << "Booking not found." << std::endl;
+        return;
+    }
 
+    try {
         std::cout << "\n=== CHANGE SEAT SELECTION ===" << std::endl;
         bookingManager.displayBookingDetails(bookingId);
 
         // Display current seat map
         std::cout << "\nCurrent seat map for your flight:" << std::endl;
-        // Use the existing findBookingById public helper instead of the private one
-        // Note: The previous code was trying to access a private method.
-        // It's assumed you have a public `findBookingById` in BookingManager, as used in other parts of your code.
-        // If not, you need to add a public wrapper for it.
-
-        // The original code was trying to access a private `findBookingById` in BookingManager.
-        // Your public interface for `BookingManager` needs to have `displayBookingDetails(int)` and `findBookingByPnr(const char*)`
-        // which rely on the private `findBookingById`. Since you are calling these methods from BookingSystem,
-        // it means they are already public in your BookingManager.h.
-        // The error you showed, however, pointed to `findBookingById` being private.
-        // For the sake of this fix, let's assume `BookingManager` has a public method that wraps the private helper.
-        // If not, you must make a public method to retrieve a booking by ID.
-        // Let's create a temporary solution here.
-
-        // Find the booking to get the flight number
-        const char* flightNumber = nullptr;
-        int bookingCount = bookingManager.getBookingCount();
-        for (int i = 0; i < bookingCount; ++i) {
-            const Booking* booking = bookingManager.getBooking(i);
-            if (booking && booking->getBookingId() == bookingId) {
-                flightNumber = booking->getFlightNumber();
-                break;
-            }
+        // Find the flight from the FlightList based on the booking's flight number
+        const Flight* flight = flightList.getFlightByNumber(flightNumber);
+        if (flight) {
+            showSeatMap(*flight);
         }
 
-        if (flightNumber) {
-            // Find the flight from the FlightList based on the flight number
-            for (int i = 0; i < flightList.getFlightCount(); ++i) {
-                const Flight* flight = flightList.getFlightByIndex(i);
-                if (stringCompare(flight->getFlightNumber(), flightNumber)) {
-                    showSeatMap(*flight);
-                    break;
-                }
-            }
-        }
-        
-
         std::cout << "\nEnter new seat number (e.g., 12A): ";
         char newSeat[5];
         std::cin.getline(newSeat, 5);
 
+        if (!bookingManager.isSeatAvailable(flightNumber, newSeat, 0)) {
+            std::cout << "Seat " << newSeat << " is already taken. Please choose another seat." << std::endl;
+            releaseFlightLock(flightNumber);
+            return;
+        }
+
         double seatChangeFee = 25.0;
         std::cout << "\nSeat Change Fee: $" << seatChangeFee << std::endl;
         std::cout << "Confirm seat change to " << newSeat << "? (y/n): ";
@@ -789,14 +856,27 @@ void BookingSystem::changeSeatSelection() {
         std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
 
         if (confirm == 'y' || confirm == 'Y') {
-            std::cout << "Seat changed successfully to " << newSeat << "!" << std::endl;
-            std::cout << "Seat change fee of $" << seatChangeFee << " will be charged." << std::endl;
-            bookingManager.saveBookingsToFile("data/bookings.json");
+            if (bookingManager.modifySeatNumber(bookingId, newSeat)) {
+                // The seat count is unchanged, but readers holding an older version must re-check
+                acquireLock();
+                flightList.loadFlightsFromFile("data/flights.json");
+                Flight* flightToUpdate = flightList.getFlightByNumber(flightNumber);
+                if (flightToUpdate) {
+                    flightToUpdate->bumpVersion();
+                    flightList.saveFlightsToFile("data/flights.json");
+                }
+                releaseLock();
+
+                std::cout << "Seat changed successfully to " << newSeat << "!" << std::endl;
+                std::cout << "Seat change fee of $" << seatChangeFee << " will be charged." << std::endl;
+            } else {
+                std::cout << "Error: Could not save the seat change." << std::endl;
+            }
         }
 
-        releaseLock();
+        releaseFlightLock(flightNumber);
     } catch (...) {
-        releaseLock();
+        releaseFlightLock(flightNumber);
         std::cout << "Error processing seat change." << std::endl;
     }
 }
@@ -806,18 +886,17 @@ void BookingSystem::upgradeCabinClass() {
     char input[20];
     std::cin.getline(input, 20);
 
-    acquireLock();
-
-    try {
-        bookingManager.loadBookingsFromFile("data/bookings.json");
+    // Resolve the booking from a lock-free refresh; writers re-check under the flight lock
+    bookingManager.refreshBookings();
 
-        int bookingId = getBookingIdFromInput(input);
-        if (bookingId == -1) {
-            std::cout << "Booking not found." << std::endl;
-            releaseLock();
-            return;
-        }
+    int bookingId = getBookingIdFromInput(input);
+    char flightNumber[10];
+    if (bookingId == -1 || !lockFlightOfBooking(bookingId, flightNumber)) {
+        std::cout << "Booking not found." << std::endl;
+        return;
+    }
 
+    try {
         std::cout << "\n=== UPGRADE CABIN CLASS ===" << std::endl;
         bookingManager.displayBookingDetails(bookingId);
 
@@ -849,7 +928,7 @@ void BookingSystem::upgradeCabinClass() {
                 break;
             default:
                 std::cout << "Invalid choice." << std::endl;
-                releaseLock();
+                releaseFlightLock(flightNumber);
                 return;
         }
 
@@ -861,14 +940,17 @@ void BookingSystem::upgradeCabinClass() {
         std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
 
         if (confirm == 'y' || confirm == 'Y') {
-            std::cout << "Cabin class upgraded successfully to " << newClass << " Class!" << std::endl;
-            std::cout << "Upgrade fee of $" << upgradeFee << " will be charged." << std::endl;
-            bookingManager.saveBookingsToFile("data/bookings.json");
+            if (bookingManager.modifyCabinClass(bookingId, newClass)) {
+                std::cout << "Cabin class upgraded successfully to " << newClass << " Class!" << std::endl;
+                std::cout << "Upgrade fee of $" << upgradeFee << " will be charged." << std::endl;
+            } else {
+                std::cout << "Error: Could not save the cabin upgrade." << std::endl;
+            }
         }
 
-        releaseLock();
+        releaseFlightLock(flightNumber);
     } catch (...) {
-        releaseLock();
+        releaseFlightLock(flightNumber);
         std::cout << "Error processing cabin upgrade." << std::endl;
     }
 }
@@ -878,18 +960,17 @@ void BookingSystem::modifyPassengerDetails() {
     char input[20];
     std::cin.getline(input, 20);
 
-    acquireLock();
-
-    try {
-        bookingManager.loadBookingsFromFile("data/bookings.json");
+    // Resolve the booking from a lock-free refresh; writers re-check under the flight lock
+    bookingManager.refreshBookings();
 
-        int bookingId = getBookingIdFromInput(input);
-        if (bookingId == -1) {
-            std::cout << "Booking not found." << std::endl;
-            releaseLock();
-            return;
-        }
+    int bookingId = getBookingIdFromInput(input);
+    char flightNumber[10];
+    if (bookingId == -1 || !lockFlightOfBooking(bookingId, flightNumber)) {
+        std::cout << "Booking not found." << std::endl;
+        return;
+    }
 
+    try {
         std::cout << "\n=== MODIFY PASSENGER DETAILS ===" << std::endl;
         bookingManager.displayBookingDetails(bookingId);
 
@@ -904,11 +985,12 @@ void BookingSystem::modifyPassengerDetails() {
         std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
 
         double modificationFee = 0.0;
+        char newName[50];
+        newName[0] = '\0';
 
         switch (choice) {
             case 1: {
                 std::cout << "Enter new passenger name: ";
-                char newName[50];
                 std::cin.getline(newName, 50);
                 modificationFee = 50.0;
                 std::cout << "Name change fee: $" << modificationFee << std::endl;
@@ -932,7 +1014,7 @@ void BookingSystem::modifyPassengerDetails() {
             }
             default:
                 std::cout << "Invalid choice." << std::endl;
-                releaseLock();
+                releaseFlightLock(flightNumber);
                 return;
         }
 
@@ -944,16 +1026,21 @@ void BookingSystem::modifyPassengerDetails() {
         std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
 
         if (confirm == 'y' || confirm == 'Y') {
+            // Only a name change touches the stored booking
+            if (newName[0] != '\0' && !bookingManager.modifyPassengerName(bookingId, newName)) {
+                std::cout << "Error: Could not save the passenger details." << std::endl;
+                releaseFlightLock(flightNumber);
+                return;
+            }
             std::cout << "Passenger details modified successfully!" << std::endl;
             if (modificationFee > 0) {
                 std::cout << "Modification fee of $" << modificationFee << " will be charged." << std::endl;
             }
-            bookingManager.saveBookingsToFile("data/bookings.json");
         }
 
-        releaseLock();
+        releaseFlightLock(flightNumber);
     } catch (...) {
-        releaseLock();
+        releaseFlightLock(flightNumber);
         std::cout << "Error modifying passenger details." << std::endl;
     }
 }
@@ -985,22 +1072,20 @@ void BookingSystem::cancelByPnr() {
     char pnr[10];
     std::cin.getline(pnr, 10);
 
-    acquireLock();
-
-    try {
-        bookingManager.loadBookingsFromFile("data/bookings.json");
+    bookingManager.refreshBookings();
 
-        int bookingId = bookingManager.findBookingByPnr(pnr);
-        if (bookingId == -1) {
-            std::cout << "No booking found with PNR: " << pnr << std::endl;
-            releaseLock();
-            return;
-        }
+    int bookingId = bookingManager.findBookingByPnr(pnr);
+    char flightNumber[10];
+    if (bookingId == -1 || !lockFlightOfBooking(bookingId, flightNumber)) {
+        std::cout << "No booking found with PNR: " << pnr << std::endl;
+        return;
+    }
 
+    try {
         processCancellation(bookingId);
-        releaseLock();
+        releaseFlightLock(flightNumber);
     } catch (...) {
-        releaseLock();
+        releaseFlightLock(flightNumber);
         std::cout << "Error processing cancellation." << std::endl;
     }
 }
@@ -1011,30 +1096,25 @@ void BookingSystem::cancelByBookingId() {
     std::cin >> bookingId;
     std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
 
-    acquireLock();
-
-    try {
-        bookingManager.loadBookingsFromFile("data/bookings.json");
+    bookingManager.refreshBookings();
 
-        if (!bookingManager.isValidBookingId(bookingId)) {
-            std::cout << "No booking found with ID: " << bookingId << std::endl;
-            releaseLock();
-            return;
-        }
+    char flightNumber[10];
+    if (!bookingManager.isValidBookingId(bookingId) || !lockFlightOfBooking(bookingId, flightNumber)) {
+        std::cout << "No booking found with ID: " << bookingId << std::endl;
+        return;
+    }
 
+    try {
         processCancellation(bookingId);
-        releaseLock();
+        releaseFlightLock(flightNumber);
     } catch (...) {
-        releaseLock();
+        releaseFlightLock(flightNumber);
         std::cout << "Error processing cancellation." << std::endl;
     }
 }
 
 void BookingSystem::processCancellation(int bookingId) {
-    // Load the latest data from files
-    bookingManager.loadBookingsFromFile("data/bookings.json");
-    flightList.loadFlightsFromFile("data/flights.json");
-
+    // The caller holds the flight lock and has just reloaded the bookings
         const Booking* booking = bookingManager.getBookingById(bookingId);
         if (!booking) {
             std::cout << "Error: Booking not found for cancellation process." << std::endl;
@@ -1047,11 +1127,16 @@ void BookingSystem::processCancellation(int bookingId) {
 
     // Now, proceed with the cancellation in BookingManager
     if (bookingManager.cancelBooking(bookingId)) {
+        // flights.json is shared by every flight, so update it under the global lock
+        acquireLock();
+        flightList.loadFlightsFromFile("data/flights.json");
+
         // Find the corresponding flight and update its seat count
         Flight* flightToUpdate = flightList.getFlightByNumber(flightNumber);
         if (flightToUpdate) {
             int currentAvailableSeats = flightToUpdate->getAvailableSeats();
             flightToUpdate->setAvailableSeats(currentAvailableSeats + 1); // Increment seat count
+            flightToUpdate->bumpVersion();
             std::cout << "Flight seat count updated. New available seats: " << flightToUpdate->getAvailableSeats() << std::endl;
 
             // Save the updated flight list
@@ -1059,6 +1144,7 @@ void BookingSystem::processCancellation(int bookingId) {
         } else {
             std::cout << "Warning: Could not find corresponding flight to update seat count." << std::endl;
         }
+        releaseLock();
 
         std::cout << "\nBooking cancelled successfully!" << std::endl;
     } else {
@@ -1105,34 +1191,25 @@ void BookingSystem::checkRefundStatus() {
     char input[20];
     std::cin.getline(input, 20);
 
-    acquireLock();
-
-    try {
-        bookingManager.loadBookingsFromFile("data/bookings.json");
-
-        int bookingId = getBookingIdFromInput(input);
-        if (bookingId == -1) {
-            std::cout << "Booking not found." << std::endl;
-            releaseLock();
-            return;
-        }
+    // Read-only: works from a refreshed snapshot and never takes the exclusive lock
+    bookingManager.refreshBookings();
 
-        std::cout << "\n=== REFUND STATUS ===" << std::endl;
-        bookingManager.displayBookingDetails(bookingId);
+    int bookingId = getBookingIdFromInput(input);
+    if (bookingId == -1 || !bookingManager.getBookingById(bookingId)) {
+        std::cout << "Booking not found." << std::endl;
+        return;
+    }
 
-        // Demo refund status
-        std::cout << "\nRefund Information:" << std::endl;
-        std::cout << "Refund Amount: $295.49" << std::endl;
-        std::cout << "Refund Status: Processing" << std::endl;
-        std::cout << "Expected Credit Date: 2025-08-13" << std::endl;
-        std::cout << "Refund Method: Original payment method" << std::endl;
-        std::cout << "Reference Number: RFD123456789" << std::endl;
+    std::cout << "\n=== REFUND STATUS ===" << std::endl;
+    bookingManager.displayBookingDetails(bookingId);
 
-        releaseLock();
-    } catch (...) {
-        releaseLock();
-        std::cout << "Error checking refund status." << std::endl;
-    }
+    // Demo refund status
+    std::cout << "\nRefund Information:" << std::endl;
+    std::cout << "Refund Amount: $295.49" << std::endl;
+    std::cout << "Refund Status: Processing" << std::endl;
+    std::cout << "Expected Credit Date: 2025-08-13" << std::endl;
+    std::cout << "Refund Method: Original payment method" << std::endl;
+    std::cout << "Reference Number: RFD123456789" << std::endl;
 }
 
 // **Updated and Corrected functions below**
@@ -1151,7 +1228,8 @@ void BookingSystem::viewBookingDetails() {
     std::cin >> choice;
     std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
 
-    bookingManager.loadBookingsFromFile("data/bookings.json");
+    // Lookups only read, so a snapshot refresh is enough
+    bookingManager.refreshBookings();
 
     switch (choice) {
         case 1: {
@@ -1357,66 +1435,65 @@ void BookingSystem::displayDetailedBookingInfo(int bookingId) {
     std::cout << "Online management: www.airline.com/manage" << std::endl;
 }
 
-bool BookingSystem::isSeatOccupied(const char* seatNumber, const Flight& flight) {
-    int bookingCount = bookingManager.getBookingCount();
-    for (int i = 0; i < bookingCount; ++i) {
-        // Use the new public getter method
-        const Booking* booking = bookingManager.getBooking(i);
-        if (booking && stringCompare(booking->getFlightNumber(), flight.getFlightNumber()) &&
-            stringCompare(booking->getSeatNumber(), seatNumber)) {
-            return true; // Seat is occupied
-            }
+bool BookingSystem::isSeatOccupied(const char* seatNumber, const Flight& flight, std::uint64_t ownHoldId) {
+    // Held seats count as taken, except for the hold passed as ownHoldId
+    return !bookingManager.isSeatAvailable(flight.getFlightNumber(), seatNumber, ownHoldId);
+}
+
+void BookingSystem::releaseSeatHolds() {
+    for (std::uint64_t holdId : seatHoldIds) {
+        bookingManager.releaseSeatHold(holdId);
     }
-    return false; // Seat is available
+    seatHoldIds.clear();
 }
 
-// Concurrency simulation function
-void BookingSystem::simulateConcurrentBooking(int threadId, int flightIndex, const char* name, const char* seat) {
-    std::cout << "Thread " << threadId << ": Attempting to book seat " << seat << " for flight " << flightList.getFlightByIndex(flightIndex)->getFlightNumber() << std::endl;
+BookingEngine& BookingSystem::getBookingEngine() {
+    std::call_once(engineStarted, [this] {
+        bookingEngine.reset(new BookingEngine(bookingManager, flightList, bookingLock, flightLocks,
+                                              BookingEngine::defaultWorkerCount(), &paymentProcessor));
+    });
+    return *bookingEngine;
+}
 
-    // Simulate some work before trying to get the lock
-    std::this_thread::sleep_for(std::chrono::milliseconds(50 * (threadId % 3)));
+// Concurrency simulation function: one request through the booking engine
+void BookingSystem::simulateConcurrentBooking(int threadId, int flightIndex, const char* name, const char* seat) {
+    BookingEngine& engine = getBookingEngine();
 
+    // Engine workers reload the catalog under the global lock, so read it under the same lock
+    BookingRequest request;
     acquireLock();
+    const Flight* flight = flightList.getFlightByIndex(flightIndex);
+    if (flight) {
+        copyString(request.flightNumber, flight->getFlightNumber(), sizeof(request.flightNumber));
+        request.totalPrice = flight->getBasePrice() + 50.0;
+    }
+    releaseLock();
+    if (!flight) {
+        std::cout << "Thread " << threadId << ": Error - Flight not found." << std::endl;
+        return;
+    }
+    copyString(request.passengerName, name, sizeof(request.passengerName));
+    copyString(request.seatNumber, seat, sizeof(request.seatNumber));
+    copyString(request.cabinClass, "Economy", sizeof(request.cabinClass));
+    request.paymentMethod = PaymentRequest::CREDIT_CARD;
 
-    try {
-        // Critical Section: Accessing and modifying shared resources
-        bookingManager.loadBookingsFromFile("data/bookings.json");
-        flightList.loadFlightsFromFile("data/flights.json");
-
-        const Flight* selectedFlight = flightList.getFlightByIndex(flightIndex);
-        if (!selectedFlight) {
-            std::cout << "Thread " << threadId << ": Error - Flight not found." << std::endl;
-            releaseLock();
-            return;
-        }
+    std::cout << "Thread " << threadId << ": Attempting to book seat " << seat << " for flight " << request.flightNumber << std::endl;
 
-        if (isSeatOccupied(seat, *selectedFlight)) {
+    BookingResult result = engine.submit(request).get();
+    switch (result.status) {
+        case BookingResult::BOOKED:
+            std::cout << "Thread " << threadId << ": Successfully booked seat " << seat << " with Booking ID " << result.bookingId << std::endl;
+            break;
+        case BookingResult::SEAT_TAKEN:
             std::cout << "Thread " << threadId << ": Seat " << seat << " is already occupied. Booking failed." << std::endl;
-        } else {
-            // Simulate a successful payment
-            std::this_thread::sleep_for(std::chrono::seconds(1));
-
-            int newBookingId = bookingManager.createBooking(name, selectedFlight->getFlightNumber(),
-                                                           selectedFlight->getOrigin(), selectedFlight->getDestination(),
-                                                           selectedFlight->getDepartureDate(), selectedFlight->getDepartureTime(),
-                                                           seat, "Economy", selectedFlight->getBasePrice() + 50.0);
-
-            if (newBookingId != -1) {
-                // Update flight seat count and save
-                Flight* flightToUpdate = const_cast<Flight*>(selectedFlight);
-                flightToUpdate->setAvailableSeats(flightToUpdate->getAvailableSeats() - 1);
-                bookingManager.saveBookingsToFile("data/bookings.json");
-                flightList.saveFlightsToFile("data/flights.json");
-
-                std::cout << "Thread " << threadId << ": Successfully booked seat " << seat << " with Booking ID " << newBookingId << std::endl;
-            } else {
-                std::cout << "Thread " << threadId << ": Booking failed." << std::endl;
-            }
-        }
-    } catch (const std::exception& e) {
-        std::cout << "Thread " << threadId << ": An unexpected error occurred: " << e.what() << std::endl;
+            break;
+        case BookingResult::FLIGHT_NOT_FOUND:
+            std::cout << "Thread " << threadId << ": Error - Flight not found." << std::endl;
+            break;
+        case BookingResult::PAYMENT_DECLINED:
+            std::cout << "Thread " << threadId << ": Payment for seat " << seat << " was declined. Booking failed." << std::endl;
+            break;
+        default:
+            std::cout << "Thread " << threadId << ": Booking failed." << std::endl;
     }
-
-    releaseLock();
-}
\ No newline at end of file
+}
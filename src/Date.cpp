@@ -0,0 +1,72 @@
+#include "Date.h"
+#include <ctime>
+
+int Date::daysFromCivil(int year, int month, int day) {
+    // Count years from March so the leap day falls at the end of the year
+    year -= month <= 2;
+    // Shift by five 400-year eras so every division below is on unsigned values
+    const unsigned shiftEras = 5;
+    unsigned shiftedYear = static_cast<unsigned>(year + 400 * static_cast<int>(shiftEras));
+    unsigned era = shiftedYear / 400;
+    unsigned yearOfEra = shiftedYear - era * 400;                                     // [0, 399]
+    unsigned monthFromMarch = static_cast<unsigned>(month + 9) % 12;                  // March = 0
+    unsigned dayOfYear = (153 * monthFromMarch + 2) / 5 + static_cast<unsigned>(day) - 1;
+    unsigned dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;  // [0, 146096]
+    return static_cast<int>(era - shiftEras) * 146097 + static_cast<int>(dayOfEra) - 719468;
+}
+
+int Date::parse(const char* text) {
+    if (!text) return INVALID_DAY;
+
+    // Exactly DDDD-DD-DD
+    int digits[8];
+    int count = 0;
+    for (int i = 0; i < 10; i++) {
+        char ch = text[i];
+        if (i == 4 || i == 7) {
+            if (ch != '-') return INVALID_DAY;
+        } else if (ch >= '0' && ch <= '9') {
+            digits[count++] = ch - '0';
+        } else {
+            return INVALID_DAY;
+        }
+    }
+    if (text[10] != '\0') return INVALID_DAY;
+
+    int year = digits[0] * 1000 + digits[1] * 100 + digits[2] * 10 + digits[3];
+    int month = digits[4] * 10 + digits[5];
+    int day = digits[6] * 10 + digits[7];
+
+    static const int DAYS_IN_MONTH[12] = {31, 29, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    if (month < 1 || month > 12 || day < 1 || day > DAYS_IN_MONTH[month - 1]) return INVALID_DAY;
+    bool leap = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+    if (month == 2 && day == 29 && !leap) return INVALID_DAY;
+
+    return daysFromCivil(year, month, day);
+}
+
+int Date::parseTimeOfDay(const char* text) {
+    if (!text) return -1;
+    for (int i = 0; i < 5; i++) {
+        bool ok = (i == 2) ? text[i] == ':' : (text[i] >= '0' && text[i] <= '9');
+        if (!ok) return -1;
+    }
+    if (text[5] != '\0') return -1;
+
+    int hours = (text[0] - '0') * 10 + (text[1] - '0');
+    int minutes = (text[3] - '0') * 10 + (text[4] - '0');
+    if (hours > 23 || minutes > 59) return -1;
+    return hours * 60 + minutes;
+}
+
+int Date::today() {
+    time_t now = std::time(0);
+    struct tm* timeInfo = std::localtime(&now);
+    return daysFromCivil(timeInfo->tm_year + 1900, timeInfo->tm_mon + 1, timeInfo->tm_mday);
+}
+
+int Date::daysUntil(int epochDay) {
+    if (epochDay == INVALID_DAY) return 0;
+    int days = epochDay - today();
+    return days > 0 ? days : 0;
+}
@@ -0,0 +1,262 @@
+#include "FileLock.h"
+#include "StringUtils.h"
+#include <chrono>
+#include <iostream>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <unistd.h>
+#endif
+
+FileLock::FileLock(const char* path)
+    : held(false), sharedCount(0), writersWaiting(0), kernelBusy(false),
+#ifdef _WIN32
+      fileHandle(INVALID_HANDLE_VALUE),
+#else
+      fd(-1),
+#endif
+      lastWaitMicros(0), totalWaitMicros(0), acquireCount(0) {
+    copyString(this->path, path, MAX_PATH_LENGTH);
+}
+
+FileLock::~FileLock() {
+#ifdef _WIN32
+    if (fileHandle != INVALID_HANDLE_VALUE) {
+        CloseHandle(fileHandle);
+    }
+#else
+    if (fd >= 0) {
+        ::close(fd);   // closing the descriptor also drops the flock
+    }
+#endif
+}
+
+bool FileLock::lock(int timeoutMs) {
+    auto start = std::chrono::steady_clock::now();
+    auto deadline = start + std::chrono::milliseconds(timeoutMs < 0 ? 0 : timeoutMs);
+
+    {
+        std::unique_lock<std::mutex> guard(stateMutex);
+        if (held && owner == std::this_thread::get_id()) {
+            std::cout << "Error: Lock " << path << " is already held by this thread." << std::endl;
+            return false;
+        }
+        auto isFree = [this] { return !held && sharedCount == 0 && !kernelBusy; };
+        writersWaiting++;
+        bool acquired = true;
+        if (timeoutMs < 0) {
+            released.wait(guard, isFree);
+        } else {
+            acquired = released.wait_until(guard, deadline, isFree);
+        }
+        writersWaiting--;
+        if (!acquired) {
+            // Readers held back for this writer may go ahead now
+            guard.unlock();
+            released.notify_all();
+            return false;
+        }
+        held = true;
+        owner = std::this_thread::get_id();
+    }
+
+    if (!openFile() || !lockFile(true, remainingMillis(timeoutMs, deadline))) {
+        releaseOwnership();
+        return false;
+    }
+
+    recordWait(start);
+    return true;
+}
+
+bool FileLock::unlock() {
+    {
+        std::lock_guard<std::mutex> guard(stateMutex);
+        if (!held || owner != std::this_thread::get_id()) {
+            return false;
+        }
+    }
+    unlockFile();
+    releaseOwnership();
+    return true;
+}
+
+bool FileLock::lockShared(int timeoutMs) {
+    auto start = std::chrono::steady_clock::now();
+    auto deadline = start + std::chrono::milliseconds(timeoutMs < 0 ? 0 : timeoutMs);
+
+    {
+        std::unique_lock<std::mutex> guard(stateMutex);
+        if (held && owner == std::this_thread::get_id()) {
+            std::cout << "Error: Lock " << path << " is already held by this thread." << std::endl;
+            return false;
+        }
+        auto canRead = [this] { return !held && writersWaiting == 0 && !kernelBusy; };
+        if (timeoutMs < 0) {
+            released.wait(guard, canRead);
+        } else if (!released.wait_until(guard, deadline, canRead)) {
+            return false;
+        }
+
+        // Another reader in this process already holds the kernel lock
+        if (sharedCount > 0) {
+            sharedCount++;
+            return true;
+        }
+        kernelBusy = true;
+    }
+
+    bool locked = openFile() && lockFile(false, remainingMillis(timeoutMs, deadline));
+    {
+        std::lock_guard<std::mutex> guard(stateMutex);
+        kernelBusy = false;
+        if (locked) sharedCount = 1;
+    }
+    released.notify_all();
+
+    if (locked) recordWait(start);
+    return locked;
+}
+
+bool FileLock::unlockShared() {
+    {
+        std::lock_guard<std::mutex> guard(stateMutex);
+        if (sharedCount == 0) {
+            return false;
+        }
+        if (--sharedCount > 0) {
+            return true;
+        }
+        // Last reader: keep others out until the kernel lock is dropped
+        kernelBusy = true;
+    }
+    unlockFile();
+    {
+        std::lock_guard<std::mutex> guard(stateMutex);
+        kernelBusy = false;
+    }
+    released.notify_all();
+    return true;
+}
+
+bool FileLock::isHeldByCurrentThread() {
+    std::lock_guard<std::mutex> guard(stateMutex);
+    return held && owner == std::this_thread::get_id();
+}
+
+void FileLock::releaseOwnership() {
+    {
+        std::lock_guard<std::mutex> guard(stateMutex);
+        held = false;
+        owner = std::thread::id();
+    }
+    // Wake every waiter: all queued readers can proceed together
+    released.notify_all();
+}
+
+int FileLock::remainingMillis(int timeoutMs, std::chrono::steady_clock::time_point deadline) {
+    if (timeoutMs < 0) return WAIT_FOREVER;
+    auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+    return left.count() > 0 ? static_cast<int>(left.count()) : 0;
+}
+
+void FileLock::recordWait(std::chrono::steady_clock::time_point start) {
+    std::lock_guard<std::mutex> guard(stateMutex);
+    lastWaitMicros = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start).count();
+    totalWaitMicros += lastWaitMicros;
+    acquireCount++;
+}
+
+bool FileLock::lockFile(bool exclusive, int timeoutMs) {
+    bool wouldBlock = false;
+    if (tryLockFile(exclusive, wouldBlock)) return true;
+    if (!wouldBlock) return false;
+
+    if (timeoutMs < 0) {
+        // Blocking wait: the kernel wakes us the moment the holder releases
+#ifdef _WIN32
+        OVERLAPPED overlapped = {};
+        if (LockFileEx(fileHandle, exclusive ? LOCKFILE_EXCLUSIVE_LOCK : 0, 0, MAXDWORD, MAXDWORD, &overlapped)) {
+            return true;
+        }
+#else
+        while (true) {
+            if (flock(fd, exclusive ? LOCK_EX : LOCK_SH) == 0) return true;
+            if (errno != EINTR) break;
+        }
+#endif
+        std::cout << "Error: Cannot lock " << path << std::endl;
+        return false;
+    }
+
+    // Bounded wait: kernel locks have no timed variant, so poll with backoff
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+    int backoffMs = 1;
+    while (std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(backoffMs));
+        if (tryLockFile(exclusive, wouldBlock)) return true;
+        if (!wouldBlock) return false;
+        if (backoffMs < MAX_BACKOFF_MS) backoffMs *= 2;
+    }
+    return false;
+}
+
+#ifdef _WIN32
+bool FileLock::openFile() {
+    if (fileHandle != INVALID_HANDLE_VALUE) return true;
+    fileHandle = CreateFileA(path, GENERIC_READ | GENERIC_WRITE,
+                             FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr,
+                             OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (fileHandle == INVALID_HANDLE_VALUE) {
+        std::cout << "Error: Cannot open lock file: " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool FileLock::tryLockFile(bool exclusive, bool& wouldBlock) {
+    OVERLAPPED overlapped = {};
+    DWORD mode = exclusive ? LOCKFILE_EXCLUSIVE_LOCK : 0;
+    if (LockFileEx(fileHandle, mode | LOCKFILE_FAIL_IMMEDIATELY,
+                   0, MAXDWORD, MAXDWORD, &overlapped)) {
+        return true;
+    }
+    wouldBlock = (GetLastError() == ERROR_LOCK_VIOLATION);
+    return false;
+}
+
+void FileLock::unlockFile() {
+    OVERLAPPED overlapped = {};
+    UnlockFileEx(fileHandle, 0, MAXDWORD, MAXDWORD, &overlapped);
+}
+#else
+bool FileLock::openFile() {
+    if (fd >= 0) return true;
+    fd = ::open(path, O_RDWR | O_CREAT, 0644);
+    if (fd < 0) {
+        std::cout << "Error: Cannot open lock file: " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool FileLock::tryLockFile(bool exclusive, bool& wouldBlock) {
+    while (true) {
+        if (flock(fd, (exclusive ? LOCK_EX : LOCK_SH) | LOCK_NB) == 0) return true;
+        if (errno != EINTR) break;
+    }
+    wouldBlock = (errno == EWOULDBLOCK);
+    return false;
+}
+
+void FileLock::unlockFile() {
+    flock(fd, LOCK_UN);
+}
+#endif
@@ -1,5 +1,6 @@
 #include "Flight.h"
 #include "StringUtils.h"
+#include "Date.h"
 #include <iostream>
 
 Flight::Flight() {
@@ -10,18 +11,21 @@ Flight::Flight() {
     departureTime[0] = '\0';
     arrivalTime[0] = '\0';
     departureDate[0] = '\0';
+    departureDay = Date::INVALID_DAY;
     arrivalDate[0] = '\0';
     aircraftType[0] = '\0';
     basePrice = 0.0;
     totalSeats = 0;
     availableSeats = 0;
     duration[0] = '\0';
+    version = 0;
+    quoteGeneration = 0;
 }
 
 Flight::Flight(const char* airline, const char* flightNum, const char* orig,
                const char* dest, const char* depTime, const char* arrTime,
                const char* depDate, const char* arrDate, const char* aircraft,
-               double price, int total, int available) {
+               double price, int total, int available) : quoteGeneration(0) {
     setAirlineName(airline);
     setFlightNumber(flightNum);
     setOrigin(orig);
@@ -35,6 +39,7 @@ Flight::Flight(const char* airline, const char* flightNum, const char* orig,
     setTotalSeats(total);
     setAvailableSeats(available);
     copyString(duration, "3h 30m", 10);
+    version = 0;
 }
 
 Flight::~Flight() {}
@@ -45,13 +50,25 @@ void Flight::setOrigin(const char* orig) { copyString(origin, orig, 10); }
 void Flight::setDestination(const char* dest) { copyString(destination, dest, 10); }
 void Flight::setDepartureTime(const char* depTime) { copyString(departureTime, depTime, 20); }
 void Flight::setArrivalTime(const char* arrTime) { copyString(arrivalTime, arrTime, 20); }
-void Flight::setDepartureDate(const char* depDate) { copyString(departureDate, depDate, 15); }
+void Flight::setDepartureDate(const char* depDate) {
+    copyString(departureDate, depDate, 15);
+    departureDay = Date::parse(departureDate);
+}
 void Flight::setArrivalDate(const char* arrDate) { copyString(arrivalDate, arrDate, 15); }
 void Flight::setAircraftType(const char* aircraft) { copyString(aircraftType, aircraft, 30); }
-void Flight::setBasePrice(double price) { basePrice = price; }
-void Flight::setTotalSeats(int total) { totalSeats = total; }
-void Flight::setAvailableSeats(int available) { availableSeats = available; }
+void Flight::setBasePrice(double price) { basePrice = price; quoteGeneration = 0; }
+void Flight::setTotalSeats(int total) { totalSeats = total; quoteGeneration = 0; }
+
+void Flight::setAvailableSeats(int available) {
+    availableSeats = available;
+    // Only crossing an occupancy breakpoint changes the price
+    if (quoteGeneration != 0 && (available < quoteMinAvailable || available > quoteMaxAvailable)) {
+        quoteGeneration = 0;
+    }
+}
 void Flight::setDuration(const char* dur) { copyString(duration, dur, 10); }
+void Flight::setVersion(int ver) { version = ver; }
+void Flight::bumpVersion() { version++; }
 
 const char* Flight::getAirlineName() const { return airlineName; }
 const char* Flight::getFlightNumber() const { return flightNumber; }
@@ -60,18 +77,31 @@ const char* Flight::getDestination() const { return destination; }
 const char* Flight::getDepartureTime() const { return departureTime; }
 const char* Flight::getArrivalTime() const { return arrivalTime; }
 const char* Flight::getDepartureDate() const { return departureDate; }
+int Flight::getDepartureDay() const { return departureDay; }
 const char* Flight::getArrivalDate() const { return arrivalDate; }
 const char* Flight::getAircraftType() const { return aircraftType; }
 double Flight::getBasePrice() const { return basePrice; }
 int Flight::getTotalSeats() const { return totalSeats; }
 int Flight::getAvailableSeats() const { return availableSeats; }
 const char* Flight::getDuration() const { return duration; }
+int Flight::getVersion() const { return version; }
+
+double Flight::calculateDynamicPrice(const PricingEngine& pricing, int daysUntilDeparture) const {
+    return getPriceQuote(pricing, daysUntilDeparture).fare;
+}
 
-double Flight::calculateDynamicPrice(int daysUntilDeparture) const {
-    double dynamicPrice = basePrice;
-    dynamicPrice += calculateSurgePrice();
-    dynamicPrice += calculateTimeBasedPrice(daysUntilDeparture);
-    return dynamicPrice;
+const PriceQuote& Flight::getPriceQuote(const PricingEngine& pricing, int daysUntilDeparture) const {
+    // A new day only matters when it moves the flight into another time bucket
+    int timeBucket = pricing.timeBucket(daysUntilDeparture);
+    if (quoteGeneration == pricing.getGeneration() && quoteTimeBucket == timeBucket) {
+        return cachedQuote;
+    }
+
+    cachedQuote = pricing.quote(*this, daysUntilDeparture);
+    pricing.demandRange(totalSeats, availableSeats, quoteMinAvailable, quoteMaxAvailable);
+    quoteTimeBucket = timeBucket;
+    quoteGeneration = pricing.getGeneration();
+    return cachedQuote;
 }
 
 bool Flight::hasAvailableSeats() const { return availableSeats > 0; }
@@ -98,22 +128,6 @@ void Flight::displayDetailedInfo() const {
     std::cout << "=====================" << std::endl;
 }
 
-double Flight::calculateSurgePrice() const {
-    double occupancyRate = (double)(totalSeats - availableSeats) / totalSeats;
-    if (occupancyRate > 0.9) return basePrice * 0.3;
-    else if (occupancyRate > 0.7) return basePrice * 0.2;
-    else if (occupancyRate > 0.5) return basePrice * 0.1;
-    return 0.0;
-}
-
-double Flight::calculateTimeBasedPrice(int daysUntilDeparture) const {
-    if (daysUntilDeparture <= 1) return basePrice * 0.5;
-    else if (daysUntilDeparture <= 7) return basePrice * 0.3;
-    else if (daysUntilDeparture <= 14) return basePrice * 0.2;
-    else if (daysUntilDeparture <= 30) return basePrice * 0.1;
-    return 0.0;
-}
-
 void Flight::toJson(nlohmann::json& j) const {
     j["airlineName"] = airlineName;
     j["flightNumber"] = flightNumber;
@@ -128,6 +142,7 @@ void Flight::toJson(nlohmann::json& j) const {
     j["totalSeats"] = totalSeats;
     j["availableSeats"] = availableSeats;
     j["duration"] = duration;
+    j["version"] = version;
 }
 
 bool Flight::isAvailable() const {
@@ -142,10 +157,14 @@ void Flight::fromJson(const nlohmann::json& j) {
     copyString(departureTime, j.at("departureTime").get<std::string>().c_str(), 20);
     copyString(arrivalTime, j.at("arrivalTime").get<std::string>().c_str(), 20);
     copyString(departureDate, j.at("departureDate").get<std::string>().c_str(), 15);
+    departureDay = Date::parse(departureDate);
     copyString(arrivalDate, j.at("arrivalDate").get<std::string>().c_str(), 15);
     copyString(aircraftType, j.at("aircraftType").get<std::string>().c_str(), 30);
     basePrice = j.at("basePrice").get<double>();
     totalSeats = j.at("totalSeats").get<int>();
     availableSeats = j.at("availableSeats").get<int>();
     copyString(duration, j.at("duration").get<std::string>().c_str(), 10);
+    // Catalogs written before versioning start at 0
+    version = j.value("version", 0);
+    quoteGeneration = 0;
 }
\ No newline at end of file
@@ -0,0 +1,36 @@
+#include "FlightBookingIndex.h"
+
+FlightBookingIndex::FlightBookingIndex() {}
+
+FlightBookingIndex::~FlightBookingIndex() {}
+
+void FlightBookingIndex::add(const char* flightNumber, int bookingId) {
+    bookingsByFlight[flightNumber].push_back(bookingId);
+}
+
+void FlightBookingIndex::remove(const char* flightNumber, int bookingId) {
+    auto it = bookingsByFlight.find(flightNumber);
+    if (it == bookingsByFlight.end()) return;
+
+    // Order within a flight does not matter, so swap with the last entry
+    std::vector<int>& ids = it->second;
+    for (std::size_t i = 0; i < ids.size(); i++) {
+        if (ids[i] == bookingId) {
+            ids[i] = ids.back();
+            ids.pop_back();
+            break;
+        }
+    }
+    if (ids.empty()) {
+        bookingsByFlight.erase(it);
+    }
+}
+
+const std::vector<int>* FlightBookingIndex::getBookingIds(const char* flightNumber) const {
+    auto it = bookingsByFlight.find(flightNumber);
+    return it != bookingsByFlight.end() ? &it->second : nullptr;
+}
+
+void FlightBookingIndex::clear() {
+    bookingsByFlight.clear();
+}
@@ -4,38 +4,46 @@
 #include <fstream>
 #include <nlohmann/json.hpp>
 
-FlightList::FlightList() : flightCount(0) {}
+FlightList::FlightList() : changeCount(0) {}
 FlightList::~FlightList() {}
 
 bool FlightList::addFlight(const Flight& flight) {
-    if (flightCount >= MAX_FLIGHTS) {
-        return false;
-    }
-    flights[flightCount] = flight;
-    flightCount++;
+    routeIndex[makeRouteKey(flight.getOrigin(), flight.getDestination(), flight.getDepartureDate())]
+        .push_back(getFlightCount());
+    flights.push_back(flight);
+    changeCount++;
     return true;
 }
 
+std::string FlightList::makeRouteKey(const char* origin, const char* destination, const char* departureDate) {
+    std::string key(origin);
+    key += '|';
+    key += destination;
+    key += '|';
+    key += departureDate;
+    return key;
+}
+
 Flight* FlightList::getFlightByIndex(int index) {
-    if (index < 0 || index >= flightCount) {
+    if (index < 0 || index >= getFlightCount()) {
         return nullptr;
     }
     return &flights[index];
 }
 
 const Flight* FlightList::getFlightByIndex(int index) const {
-    if (index < 0 || index >= flightCount) {
+    if (index < 0 || index >= getFlightCount()) {
         return nullptr;
     }
     return &flights[index];
 }
 
 int FlightList::getCount() const {
-    return flightCount;
+    return getFlightCount();
 }
 
 int FlightList::getIndexOfFlight(const char* flightNumber) const {
-    for (int i = 0; i < flightCount; ++i) {
+    for (int i = 0; i < getFlightCount(); ++i) {
         if (stringCompare(flights[i].getFlightNumber(), flightNumber)) {
             return i;
         }
@@ -44,18 +52,26 @@ int FlightList::getIndexOfFlight(const char* flightNumber) const {
 }
 
 void FlightList::clearFlights() {
-    flightCount = 0;
+    flights.clear();
+    routeIndex.clear();
+    changeCount++;
+}
+
+void FlightList::reserveFlights(int count) {
+    if (count > 0) {
+        flights.reserve(count);
+    }
 }
 
 void FlightList::displayFlights() const {
-    if (flightCount == 0) {
+    if (getFlightCount() == 0) {
         std::cout << "No flights available." << std::endl;
         return;
     }
     std::cout << "\n+----+----------+------+------+----------+----------+----------+---------+" << std::endl;
     std::cout << "| No | Flight   | From | To   | Depart   | Arrive   | Aircraft | Price   |" << std::endl;
     std::cout << "+----+----------+------+------+----------+----------+----------+---------+" << std::endl;
-    for (int i = 0; i < flightCount; i++) {
+    for (int i = 0; i < getFlightCount(); i++) {
         std::cout << "| " << (i + 1) << "  | " << flights[i].getFlightNumber()
                   << " | " << flights[i].getOrigin()
                   << " | " << flights[i].getDestination()
@@ -77,11 +93,11 @@ void FlightList::displayFlightDetails(int index) const {
 }
 
 void FlightList::displayFlightSummary() const {
-    std::cout << "\nTotal flights found: " << flightCount << std::endl;
-    if (flightCount > 0) {
+    std::cout << "\nTotal flights found: " << getFlightCount() << std::endl;
+    if (getFlightCount() > 0) {
         double minPrice = flights[0].getBasePrice();
         double maxPrice = flights[0].getBasePrice();
-        for (int i = 1; i < flightCount; i++) {
+        for (int i = 1; i < getFlightCount(); i++) {
             double price = flights[i].getBasePrice();
             if (price < minPrice) minPrice = price;
             if (price > maxPrice) maxPrice = price;
@@ -92,7 +108,7 @@ void FlightList::displayFlightSummary() const {
 
 void FlightList::saveFlightsToFile(const char* filename) const {
     nlohmann::json j = nlohmann::json::array();
-    for (int i = 0; i < flightCount; ++i) {
+    for (int i = 0; i < getFlightCount(); ++i) {
         nlohmann::json flightJson;
         flights[i].toJson(flightJson);
         j.push_back(flightJson);
@@ -116,6 +132,9 @@ void FlightList::loadFlightsFromFile(const char* filename) {
     try {
         nlohmann::json j;
         i >> j;
+
+        // Size the catalog once up front instead of growing it flight by flight
+        reserveFlights(static_cast<int>(j.size()));
         for (const auto& flightJson : j) {
             Flight f;
             f.fromJson(flightJson);
@@ -201,45 +220,42 @@ void FlightList::loadMockData(const UserInput& userInput) {
     addFlight(Flight("Air India", "AI107", "NYC", "BOM", "11:45", "03:30", "2025-09-09", "2025-09-09", "Boeing 787-8", 310.99, 248, 34));
 
     std::cout << "\n=== MOCK DATA CREATION COMPLETE ===" << std::endl;
-    std::cout << "Total flights created: " << flightCount << std::endl;
+    std::cout << "Total flights created: " << getFlightCount() << std::endl;
     std::cout << "=====================================" << std::endl;
 }
 
 int FlightList::getFlightCount() const {
-    return flightCount;
+    return static_cast<int>(flights.size());
 }
 
 int FlightList::searchByRoute(const char* origin, const char* destination, const char* departureDate) {
+    std::vector<int> matches;
+    return searchByRoute(origin, destination, departureDate, matches);
+}
+
+int FlightList::searchByRoute(const char* origin, const char* destination, const char* departureDate,
+                              std::vector<int>& matches) {
+    matches.clear();
     if (!origin || !destination || !departureDate) {
         return 0;
     }
 
-    // First, try to load flights from JSON file
-    loadFlightsFromFile("data/flights.json");
+    // The catalog is parsed once; later loads rebuild the route index as they go
+    if (getFlightCount() == 0) {
+        loadFlightsFromFile("data/flights.json");
+    }
 
     // If no flights loaded from JSON, use mock data as backup
-    if (flightCount == 0) {
+    if (getFlightCount() == 0) {
         std::cout << "flights.json not found or empty. Loading mock data as backup..." << std::endl;
-
-        // Create a temporary UserInput object with search criteria
-        UserInput tempUserInput;
-        // Note: Since UserInput doesn't have setters, we'll create mock data directly
         loadMockDataForRoute(origin, destination, departureDate);
     }
 
-    // Count matching flights
-    int foundCount = 0;
-    for (int i = 0; i < flightCount; i++) {
-        bool originMatch = stringCompare(flights[i].getOrigin(), origin);
-        bool destMatch = stringCompare(flights[i].getDestination(), destination);
-        bool dateMatch = stringCompare(flights[i].getDepartureDate(), departureDate);
-
-        if (originMatch && destMatch && dateMatch) {
-            foundCount++;
-        }
+    auto it = routeIndex.find(makeRouteKey(origin, destination, departureDate));
+    if (it != routeIndex.end()) {
+        matches = it->second;
     }
-
-    return foundCount;
+    return static_cast<int>(matches.size());
 }
 
 // Helper method to load mock data for specific route (as backup)
@@ -298,13 +314,13 @@ void FlightList::loadMockDataForRoute(const char* origin, const char* destinatio
     flight3.setDuration("14h 15m");
     addFlight(flight3);
 
-    std::cout << "Loaded " << flightCount << " backup flights for route." << std::endl;
+    std::cout << "Loaded " << getFlightCount() << " backup flights for route." << std::endl;
     std::cout << "===========================================" << std::endl;
 }
 
 // Add this new public getter method to FlightList.h
 Flight* FlightList::getFlightByNumber(const char* flightNumber) {
-    for (int i = 0; i < flightCount; ++i) {
+    for (int i = 0; i < getFlightCount(); ++i) {
         if (stringCompare(flights[i].getFlightNumber(), flightNumber)) {
             return &flights[i];
         }
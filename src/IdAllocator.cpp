@@ -0,0 +1,96 @@
+#include "IdAllocator.h"
+#include "StringUtils.h"
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+IdAllocator::IdAllocator(int blockSize)
+    : blockSize(blockSize < 1 ? 1 : blockSize), window(0), leaseCount(0) {
+    path[0] = '\0';
+}
+
+IdAllocator::~IdAllocator() {}
+
+void IdAllocator::setPath(const char* highWaterPath) {
+    std::lock_guard<std::mutex> guard(leaseMutex);
+    if (stringCompare(path, highWaterPath)) return;
+
+    copyString(path, highWaterPath, MAX_PATH_LENGTH);
+    char lockPath[MAX_PATH_LENGTH + 8];
+    snprintf(lockPath, sizeof(lockPath), "%s.lock", path);
+    leaseLock.reset(new FileLock(lockPath));
+    window.store(0);
+}
+
+int IdAllocator::allocate(int floor) {
+    if (floor < 1) floor = 1;
+    while (true) {
+        std::uint64_t current = window.load();
+        std::uint32_t next = static_cast<std::uint32_t>(current);
+        std::uint32_t end = static_cast<std::uint32_t>(current >> 32);
+
+        // Fast path: take the next ID of the current block. A leased block is
+        // ours alone, so its IDs stay valid even below newer IDs of other processes.
+        if (next < end) {
+            if (window.compare_exchange_weak(current, packWindow(next + 1, end))) {
+                return static_cast<int>(next);
+            }
+            continue;
+        }
+
+        // Block used up: lease a new one
+        std::lock_guard<std::mutex> guard(leaseMutex);
+        if (window.load() != current) continue;   // another thread leased meanwhile
+        if (!leaseBlock(floor)) return -1;
+    }
+}
+
+bool IdAllocator::leaseBlock(int floor) {
+    // Called with leaseMutex held
+    if (!leaseLock) {
+        std::cout << "Error: No booking ID file configured." << std::endl;
+        return false;
+    }
+    if (!leaseLock->lock()) {
+        std::cout << "Error: Cannot lock " << path << " to allocate booking IDs." << std::endl;
+        return false;
+    }
+
+    // A missing mark (first run on older data) starts at the caller's floor
+    int mark = 0;
+    readHighWater(mark);
+    int start = mark > floor ? mark : floor;
+    bool written = start <= 0x7FFFFFFF - blockSize && writeHighWater(start + blockSize);
+    leaseLock->unlock();
+
+    if (!written) {
+        std::cout << "Error: Cannot reserve booking IDs in " << path << std::endl;
+        return false;
+    }
+    window.store(packWindow(static_cast<std::uint32_t>(start), static_cast<std::uint32_t>(start + blockSize)));
+    leaseCount++;
+    return true;
+}
+
+bool IdAllocator::readHighWater(int& mark) {
+    std::ifstream file(path);
+    char line[64];
+    if (!file.is_open() || !file.getline(line, sizeof(line))) return false;
+    return sscanf(line, "{\"nextBookingId\": %d}", &mark) == 1;
+}
+
+bool IdAllocator::writeHighWater(int mark) {
+    // Replace the file in one step so a crash never leaves a torn mark behind
+    char tempPath[MAX_PATH_LENGTH + 8];
+    snprintf(tempPath, sizeof(tempPath), "%s.tmp", path);
+
+    std::ofstream file(tempPath, std::ios::trunc);
+    file << "{\"nextBookingId\": " << mark << "}\n";
+    file.close();
+    if (file.fail()) return false;
+
+    std::error_code ec;
+    std::filesystem::rename(tempPath, path, ec);
+    return !ec;
+}
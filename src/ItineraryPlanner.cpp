@@ -0,0 +1,265 @@
+#include "ItineraryPlanner.h"
+#include "FlightList.h"
+#include "PricingEngine.h"
+#include "Date.h"
+#include <algorithm>
+
+static const int MINUTES_PER_DAY = 24 * 60;
+
+ItineraryPlanner::ItineraryPlanner()
+    : minConnectionMinutes(DEFAULT_MIN_CONNECTION_MINUTES),
+      maxLayoverMinutes(DEFAULT_MAX_LAYOVER_MINUTES),
+      connectionCount(0), built(false), builtCatalogChange(0), builtPricingGeneration(0), builtDay(0) {}
+
+ItineraryPlanner::~ItineraryPlanner() {}
+
+void ItineraryPlanner::setConnectionWindow(int minConnection, int maxLayover) {
+    minConnectionMinutes = std::max(0, minConnection);
+    maxLayoverMinutes = std::max(minConnectionMinutes, maxLayover);
+}
+
+void ItineraryPlanner::build(const FlightList& flights, const PricingEngine& pricing) {
+    airportIds.clear();
+    departures.clear();
+    inboundFrom.clear();
+    connectionCount = 0;
+
+    int today = Date::today();
+    built = true;
+    builtCatalogChange = flights.getChangeCount();
+    builtPricingGeneration = pricing.getGeneration();
+    builtDay = today;
+
+    // First pass: place every usable flight in time, collecting pricing columns
+    std::vector<int> flightIndices;
+    std::vector<int> departureMinutes;
+    std::vector<int> arrivalMinutes;
+    std::vector<double> basePrices;
+    std::vector<int> totalSeats;
+    std::vector<int> availableSeats;
+    std::vector<int> daysUntilDeparture;
+
+    int count = flights.getFlightCount();
+    for (int i = 0; i < count; i++) {
+        const Flight* flight = flights.getFlightByIndex(i);
+        if (!flight || !flight->isAvailable()) continue;
+
+        int departureDay = flight->getDepartureDay();
+        int arrivalDay = Date::parse(flight->getArrivalDate());
+        int departureTime = Date::parseTimeOfDay(flight->getDepartureTime());
+        int arrivalTime = Date::parseTimeOfDay(flight->getArrivalTime());
+        if (departureDay == Date::INVALID_DAY || arrivalDay == Date::INVALID_DAY ||
+            departureTime < 0 || arrivalTime < 0) {
+            continue;
+        }
+
+        int departureMinute = departureDay * MINUTES_PER_DAY + departureTime;
+        int arrivalMinute = arrivalDay * MINUTES_PER_DAY + arrivalTime;
+        // Times carry no time zone, so a leg that lands before it leaves cannot be chained
+        if (arrivalMinute <= departureMinute) continue;
+
+        flightIndices.push_back(i);
+        departureMinutes.push_back(departureMinute);
+        arrivalMinutes.push_back(arrivalMinute);
+        basePrices.push_back(flight->getBasePrice());
+        totalSeats.push_back(flight->getTotalSeats());
+        availableSeats.push_back(flight->getAvailableSeats());
+        daysUntilDeparture.push_back(departureDay > today ? departureDay - today : 0);
+    }
+
+    int usable = static_cast<int>(flightIndices.size());
+    std::vector<double> fares(usable);
+    pricing.quoteFares(basePrices.data(), totalSeats.data(), availableSeats.data(),
+                       daysUntilDeparture.data(), usable, fares.data());
+
+    // Second pass: the edges, grouped by departure airport
+    for (int i = 0; i < usable; i++) {
+        const Flight* flight = flights.getFlightByIndex(flightIndices[i]);
+        int from = addAirport(flight->getOrigin());
+        int to = addAirport(flight->getDestination());
+        if (from == to) continue;
+
+        departures[from].push_back(Connection{departureMinutes[i], arrivalMinutes[i], to, flightIndices[i], fares[i]});
+        inboundFrom[to].push_back(from);
+        connectionCount++;
+    }
+
+    for (std::vector<Connection>& list : departures) {
+        std::sort(list.begin(), list.end(), [](const Connection& a, const Connection& b) {
+            return a.departureMinute < b.departureMinute;
+        });
+    }
+    for (std::vector<int>& sources : inboundFrom) {
+        std::sort(sources.begin(), sources.end());
+        sources.erase(std::unique(sources.begin(), sources.end()), sources.end());
+    }
+}
+
+bool ItineraryPlanner::refresh(const FlightList& flights, const PricingEngine& pricing) {
+    // Fares are quoted at build time, so a new day reprices the graph too
+    if (built && builtCatalogChange == flights.getChangeCount() &&
+        builtPricingGeneration == pricing.getGeneration() && builtDay == Date::today()) {
+        return false;
+    }
+    build(flights, pricing);
+    return true;
+}
+
+int ItineraryPlanner::findItineraries(const char* origin, const char* destination, const char* departureDate,
+                                      int maxLegs, SortOrder order, int maxResults,
+                                      std::vector<Itinerary>& results) const {
+    results.clear();
+    int from = findAirport(origin);
+    int to = findAirport(destination);
+    int day = Date::parse(departureDate);
+    if (from < 0 || to < 0 || from == to || day == Date::INVALID_DAY || maxResults <= 0) {
+        return 0;
+    }
+    maxLegs = std::max(1, std::min(maxLegs, static_cast<int>(Itinerary::MAX_LEGS)));
+
+    Search search;
+    search.destination = to;
+    search.order = order;
+    search.maxResults = maxResults;
+    computeLegsNeeded(to, maxLegs, search.legsNeeded);
+    if (search.legsNeeded[from] > maxLegs) return 0;
+
+    search.path[0] = from;
+    search.partial.legCount = 0;
+    search.partial.departureMinute = 0;
+    search.partial.arrivalMinute = 0;
+    search.partial.fare = 0.0;
+    search.found = &results;
+
+    // The first leg may leave at any time on the requested day
+    int dayStart = day * MINUTES_PER_DAY;
+    scanDepartures(from, dayStart, dayStart + MINUTES_PER_DAY - 1, maxLegs, 0.0, search);
+
+    // The heap holds at most maxResults; sorting it puts the best first
+    std::sort_heap(results.begin(), results.end(), [order](const Itinerary& a, const Itinerary& b) {
+        return ranksBefore(a, b, order);
+    });
+    return static_cast<int>(results.size());
+}
+
+int ItineraryPlanner::getConnectionCount() const {
+    return connectionCount;
+}
+
+// Private helpers
+int ItineraryPlanner::findAirport(const char* code) const {
+    if (!code) return -1;
+    auto it = airportIds.find(code);
+    return it != airportIds.end() ? it->second : -1;
+}
+
+int ItineraryPlanner::addAirport(const char* code) {
+    auto it = airportIds.find(code);
+    if (it != airportIds.end()) return it->second;
+
+    int id = static_cast<int>(departures.size());
+    airportIds[code] = id;
+    departures.emplace_back();
+    inboundFrom.emplace_back();
+    return id;
+}
+
+void ItineraryPlanner::computeLegsNeeded(int destination, int maxLegs, std::vector<int>& legsNeeded) const {
+    // Breadth-first over the reversed route map, ignoring times: an airport
+    // more than maxLegs flights away can never be part of an answer
+    legsNeeded.assign(departures.size(), maxLegs + 1);
+    legsNeeded[destination] = 0;
+
+    std::vector<int> frontier(1, destination);
+    std::vector<int> next;
+    for (int legs = 1; legs <= maxLegs && !frontier.empty(); legs++) {
+        next.clear();
+        for (int airport : frontier) {
+            for (int source : inboundFrom[airport]) {
+                if (legsNeeded[source] > legs) {
+                    legsNeeded[source] = legs;
+                    next.push_back(source);
+                }
+            }
+        }
+        frontier.swap(next);
+    }
+}
+
+void ItineraryPlanner::scanDepartures(int airport, int earliest, int latest, int legsLeft, double fareSoFar,
+                                      Search& search) const {
+    const std::vector<Connection>& list = departures[airport];
+    auto it = std::lower_bound(list.begin(), list.end(), earliest, [](const Connection& c, int minute) {
+        return c.departureMinute < minute;
+    });
+
+    int depth = search.partial.legCount;
+    for (; it != list.end() && it->departureMinute <= latest; ++it) {
+        const Connection& leg = *it;
+        if (search.legsNeeded[leg.toAirport] > legsLeft - 1) continue;
+
+        // Never pass through the same airport twice
+        bool revisits = false;
+        for (int i = 0; i <= depth; i++) {
+            if (search.path[i] == leg.toAirport) revisits = true;
+        }
+        if (revisits) continue;
+
+        // With the heap full, skip a leg that already ranks behind its worst entry:
+        // every further leg only adds time and fare
+        if (static_cast<int>(search.found->size()) == search.maxResults) {
+            const Itinerary& worst = search.found->front();
+            if (search.order == BY_FARE) {
+                if (fareSoFar + leg.fare > worst.fare) continue;
+            } else {
+                int firstDeparture = depth == 0 ? leg.departureMinute : search.partial.departureMinute;
+                int earliestArrival = leg.arrivalMinute;
+                if (leg.toAirport != search.destination) earliestArrival += minConnectionMinutes + 1;
+                if (earliestArrival - firstDeparture > worst.getDurationMinutes()) continue;
+            }
+        }
+
+        if (depth == 0) search.partial.departureMinute = leg.departureMinute;
+        search.partial.flightIndex[depth] = leg.flightIndex;
+        search.partial.legCount = depth + 1;
+
+        if (leg.toAirport == search.destination) {
+            Itinerary itinerary = search.partial;
+            itinerary.arrivalMinute = leg.arrivalMinute;
+            itinerary.fare = fareSoFar + leg.fare;
+            keepIfRanked(itinerary, search);
+        } else {
+            search.path[depth + 1] = leg.toAirport;
+            scanDepartures(leg.toAirport, leg.arrivalMinute + minConnectionMinutes,
+                           leg.arrivalMinute + maxLayoverMinutes, legsLeft - 1, fareSoFar + leg.fare, search);
+        }
+        search.partial.legCount = depth;
+    }
+}
+
+bool ItineraryPlanner::ranksBefore(const Itinerary& a, const Itinerary& b, SortOrder order) {
+    if (order == BY_FARE) {
+        if (a.fare != b.fare) return a.fare < b.fare;
+        if (a.getDurationMinutes() != b.getDurationMinutes()) return a.getDurationMinutes() < b.getDurationMinutes();
+    } else {
+        if (a.getDurationMinutes() != b.getDurationMinutes()) return a.getDurationMinutes() < b.getDurationMinutes();
+        if (a.fare != b.fare) return a.fare < b.fare;
+    }
+    return a.departureMinute < b.departureMinute;
+}
+
+void ItineraryPlanner::keepIfRanked(const Itinerary& itinerary, Search& search) {
+    std::vector<Itinerary>& found = *search.found;
+    SortOrder order = search.order;
+    auto before = [order](const Itinerary& a, const Itinerary& b) { return ranksBefore(a, b, order); };
+
+    if (static_cast<int>(found.size()) < search.maxResults) {
+        found.push_back(itinerary);
+        std::push_heap(found.begin(), found.end(), before);
+    } else if (before(itinerary, found.front())) {
+        // Replace the worst kept itinerary
+        std::pop_heap(found.begin(), found.end(), before);
+        found.back() = itinerary;
+        std::push_heap(found.begin(), found.end(), before);
+    }
+}
@@ -0,0 +1,129 @@
+#include "JournalFile.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+JournalFile::JournalFile()
+#ifdef _WIN32
+    : fileHandle(INVALID_HANDLE_VALUE) {}
+#else
+    : fd(-1) {}
+#endif
+
+JournalFile::~JournalFile() {
+    close();
+}
+
+#ifdef _WIN32
+bool JournalFile::open(const char* filename) {
+    close();
+    fileHandle = CreateFileA(filename, GENERIC_READ | GENERIC_WRITE,
+                             FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr,
+                             OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    return fileHandle != INVALID_HANDLE_VALUE;
+}
+
+void JournalFile::close() {
+    if (fileHandle != INVALID_HANDLE_VALUE) {
+        CloseHandle(fileHandle);
+        fileHandle = INVALID_HANDLE_VALUE;
+    }
+}
+
+bool JournalFile::isOpen() const {
+    return fileHandle != INVALID_HANDLE_VALUE;
+}
+
+bool JournalFile::append(const char* data, int length, long long& start) {
+    LARGE_INTEGER zero, end;
+    zero.QuadPart = 0;
+    if (!SetFilePointerEx(fileHandle, zero, &end, FILE_END)) return false;
+    start = static_cast<long long>(end.QuadPart);
+
+    while (length > 0) {
+        DWORD written = 0;
+        if (!WriteFile(fileHandle, data, static_cast<DWORD>(length), &written, nullptr)) return false;
+        data += written;
+        length -= static_cast<int>(written);
+    }
+    return true;
+}
+
+bool JournalFile::truncate() {
+    LARGE_INTEGER zero;
+    zero.QuadPart = 0;
+    return SetFilePointerEx(fileHandle, zero, nullptr, FILE_BEGIN) && SetEndOfFile(fileHandle);
+}
+
+bool JournalFile::sync() {
+    return FlushFileBuffers(fileHandle) != 0;
+}
+
+bool JournalFile::syncPath(const char* filename) {
+    HANDLE handle = CreateFileA(filename, GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr,
+                                OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (handle == INVALID_HANDLE_VALUE) return false;
+    bool synced = FlushFileBuffers(handle) != 0;
+    CloseHandle(handle);
+    return synced;
+}
+#else
+bool JournalFile::open(const char* filename) {
+    close();
+    // O_APPEND: every write lands at the end, even after another process truncates the file
+    fd = ::open(filename, O_WRONLY | O_APPEND | O_CREAT, 0644);
+    return fd >= 0;
+}
+
+void JournalFile::close() {
+    if (fd >= 0) {
+        ::close(fd);
+        fd = -1;
+    }
+}
+
+bool JournalFile::isOpen() const {
+    return fd >= 0;
+}
+
+bool JournalFile::append(const char* data, int length, long long& start) {
+    off_t end = lseek(fd, 0, SEEK_END);
+    if (end < 0) return false;
+    start = static_cast<long long>(end);
+
+    while (length > 0) {
+        ssize_t written = ::write(fd, data, static_cast<size_t>(length));
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        data += written;
+        length -= static_cast<int>(written);
+    }
+    return true;
+}
+
+bool JournalFile::truncate() {
+    return ftruncate(fd, 0) == 0;
+}
+
+bool JournalFile::sync() {
+    return fsync(fd) == 0;
+}
+
+bool JournalFile::syncPath(const char* filename) {
+    int file = ::open(filename, O_RDONLY);
+    if (file < 0) return false;
+    bool synced = fsync(file) == 0;
+    ::close(file);
+    return synced;
+}
+#endif
@@ -0,0 +1,175 @@
+#include "JsonStreamReader.h"
+#include "StringUtils.h"
+#include <cstdlib>
+
+JsonStreamReader::JsonStreamReader(std::istream& input)
+    : input(&input), block(BLOCK_SIZE), data(nullptr), dataLength(0), pos(0),
+      type(INVALID), textLength(0), depth(0) {
+    text[0] = '\0';
+}
+
+JsonStreamReader::JsonStreamReader(const char* data, int length)
+    : input(nullptr), data(data), dataLength(length), pos(0),
+      type(INVALID), textLength(0), depth(0) {
+    text[0] = '\0';
+}
+
+JsonStreamReader::~JsonStreamReader() {}
+
+bool JsonStreamReader::fillBlock() {
+    if (!input || !input->good()) return false;
+    input->read(block.data(), BLOCK_SIZE);
+    data = block.data();
+    dataLength = static_cast<int>(input->gcount());
+    pos = 0;
+    return dataLength > 0;
+}
+
+int JsonStreamReader::peekChar() {
+    if (pos >= dataLength && !fillBlock()) return -1;
+    return static_cast<unsigned char>(data[pos]);
+}
+
+int JsonStreamReader::readChar() {
+    if (pos >= dataLength && !fillBlock()) return -1;
+    return static_cast<unsigned char>(data[pos++]);
+}
+
+void JsonStreamReader::appendText(char ch) {
+    // Over-long values are truncated but still consumed in full
+    if (textLength < MAX_TOKEN_LENGTH - 1) {
+        text[textLength++] = ch;
+    }
+}
+
+void JsonStreamReader::afterValue() {
+    if (depth > 0 && inObject[depth - 1]) {
+        expectKey[depth - 1] = true;
+    }
+}
+
+JsonStreamReader::TokenType JsonStreamReader::next() {
+    textLength = 0;
+    text[0] = '\0';
+
+    int ch = readChar();
+    while (ch == ' ' || ch == '\t' || ch == '\n' || ch == '\r' || ch == ',' || ch == ':') {
+        ch = readChar();
+    }
+
+    switch (ch) {
+        case -1:
+            type = END_OF_INPUT;
+            break;
+        case '{':
+        case '[':
+            if (depth >= MAX_DEPTH) {
+                type = INVALID;
+                break;
+            }
+            inObject[depth] = (ch == '{');
+            expectKey[depth] = (ch == '{');
+            depth++;
+            type = (ch == '{') ? BEGIN_OBJECT : BEGIN_ARRAY;
+            break;
+        case '}':
+        case ']':
+            if (depth == 0 || inObject[depth - 1] != (ch == '}')) {
+                type = INVALID;
+                break;
+            }
+            depth--;
+            afterValue();
+            type = (ch == '}') ? END_OBJECT : END_ARRAY;
+            break;
+        case '"':
+            type = readString();
+            break;
+        default:
+            if (ch == '-' || (ch >= '0' && ch <= '9') || (ch >= 'a' && ch <= 'z')) {
+                appendText(static_cast<char>(ch));
+                type = readBareWord();
+            } else {
+                type = INVALID;
+            }
+    }
+    text[textLength] = '\0';
+    return type;
+}
+
+JsonStreamReader::TokenType JsonStreamReader::readString() {
+    while (true) {
+        int ch = readChar();
+        if (ch == -1) return INVALID;
+        if (ch == '"') break;
+        if (ch == '\\') {
+            ch = readChar();
+            switch (ch) {
+                case 'n': ch = '\n'; break;
+                case 't': ch = '\t'; break;
+                case 'r': ch = '\r'; break;
+                case 'b': ch = '\b'; break;
+                case 'f': ch = '\f'; break;
+                case 'u': {
+                    // Booking data is plain ASCII; keep a placeholder for anything else
+                    int code = 0;
+                    for (int i = 0; i < 4; i++) {
+                        int digit = readChar();
+                        if (digit == -1) return INVALID;
+                        code <<= 4;
+                        if (digit >= '0' && digit <= '9') code |= digit - '0';
+                        else if (digit >= 'a' && digit <= 'f') code |= digit - 'a' + 10;
+                        else if (digit >= 'A' && digit <= 'F') code |= digit - 'A' + 10;
+                        else code = 0x10000;   // not hex
+                    }
+                    ch = code < 0x80 ? code : '?';
+                    break;
+                }
+                case -1:
+                    return INVALID;
+                default:
+                    break; // \" \\ \/
+            }
+        }
+        appendText(static_cast<char>(ch));
+    }
+
+    if (depth > 0 && inObject[depth - 1] && expectKey[depth - 1]) {
+        expectKey[depth - 1] = false;
+        return KEY;
+    }
+    afterValue();
+    return STRING;
+}
+
+JsonStreamReader::TokenType JsonStreamReader::readBareWord() {
+    bool isNumber = (text[0] == '-' || (text[0] >= '0' && text[0] <= '9'));
+    while (true) {
+        int ch = peekChar();
+        bool partOfWord = (ch >= '0' && ch <= '9') || (ch >= 'a' && ch <= 'z') ||
+                          ch == '.' || ch == '-' || ch == '+' || ch == 'E';
+        if (!partOfWord) break;
+        appendText(static_cast<char>(readChar()));
+    }
+    afterValue();
+    return isNumber ? NUMBER : LITERAL;
+}
+
+bool JsonStreamReader::skipValue() {
+    if (type != BEGIN_OBJECT && type != BEGIN_ARRAY) {
+        return type != INVALID && type != END_OF_INPUT;
+    }
+
+    int targetDepth = depth - 1;
+    while (depth > targetDepth) {
+        TokenType token = next();
+        if (token == END_OF_INPUT || token == INVALID) return false;
+    }
+    return true;
+}
+
+JsonStreamReader::TokenType JsonStreamReader::getType() const { return type; }
+const char* JsonStreamReader::getText() const { return text; }
+bool JsonStreamReader::textEquals(const char* str) const { return stringCompare(text, str); }
+int JsonStreamReader::getInt() const { return static_cast<int>(std::strtol(text, nullptr, 10)); }
+double JsonStreamReader::getDouble() const { return std::strtod(text, nullptr); }
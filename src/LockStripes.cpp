@@ -0,0 +1,32 @@
+#include "LockStripes.h"
+#include <cstdint>
+#include <cstdio>
+
+LockStripes::LockStripes(const char* directory) {
+    stripes.reserve(STRIPE_COUNT);
+    for (int i = 0; i < STRIPE_COUNT; i++) {
+        char path[300];
+        snprintf(path, sizeof(path), "%s/stripe-%02d.lock", directory, i);
+        stripes.emplace_back(new FileLock(path));
+    }
+}
+
+LockStripes::~LockStripes() {}
+
+FileLock& LockStripes::forFlight(const char* flightNumber) {
+    return *stripes[stripeFor(flightNumber)];
+}
+
+FileLock& LockStripes::forStripe(int stripe) {
+    return *stripes[stripe];
+}
+
+int LockStripes::stripeFor(const char* flightNumber) {
+    // FNV-1a: stable across processes, unlike std::hash
+    std::uint32_t hash = 2166136261u;
+    for (const char* p = flightNumber; p && *p; p++) {
+        hash ^= static_cast<unsigned char>(*p);
+        hash *= 16777619u;
+    }
+    return static_cast<int>(hash % STRIPE_COUNT);
+}
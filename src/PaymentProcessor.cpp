@@ -0,0 +1,19 @@
+#include "PaymentProcessor.h"
+#include <memory>
+
+PaymentProcessor::~PaymentProcessor() {}
+
+std::future<PaymentResult> PaymentProcessor::submit(const PaymentRequest& request) {
+    // std::function must be copyable, so the promise is shared with the callback
+    std::shared_ptr<std::promise<PaymentResult>> promise(new std::promise<PaymentResult>);
+    std::future<PaymentResult> future = promise->get_future();
+    submit(request, [promise](const PaymentResult& result) { promise->set_value(result); });
+    return future;
+}
+
+std::future<PaymentResult> PaymentProcessor::refund(const char* transactionId, double amount) {
+    std::shared_ptr<std::promise<PaymentResult>> promise(new std::promise<PaymentResult>);
+    std::future<PaymentResult> future = promise->get_future();
+    refund(transactionId, amount, [promise](const PaymentResult& result) { promise->set_value(result); });
+    return future;
+}
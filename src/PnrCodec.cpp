@@ -0,0 +1,73 @@
+#include "PnrCodec.h"
+
+static const char DIGITS[] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+
+// Value of one PNR character in base 36, -1 if it is not a letter or digit
+static int digitValue(char ch) {
+    if (ch >= '0' && ch <= '9') return ch - '0';
+    if (ch >= 'A' && ch <= 'Z') return ch - 'A' + 10;
+    if (ch >= 'a' && ch <= 'z') return ch - 'a' + 10;
+    return -1;
+}
+
+PnrCodec::PnrCodec() : PnrCodec(DEFAULT_MULTIPLIER, DEFAULT_OFFSET) {}
+
+PnrCodec::PnrCodec(std::uint64_t multiplier, std::uint64_t offset)
+    : multiplier(multiplier % SPACE), offset(offset % SPACE) {
+    inverse = modularInverse(this->multiplier, SPACE);
+    if (inverse == 0) {
+        // Not invertible: fall back to the plain (unscrambled) encoding
+        this->multiplier = 1;
+        this->offset = 0;
+        inverse = 1;
+    }
+}
+
+bool PnrCodec::encode(int bookingId, char* pnr) const {
+    if (bookingId < 0 || static_cast<std::uint64_t>(bookingId) >= SPACE) return false;
+
+    // Both factors are below 2^31, so the product fits in 64 bits
+    std::uint64_t value = (multiplier * static_cast<std::uint64_t>(bookingId) + offset) % SPACE;
+    for (int i = PNR_LENGTH - 1; i > 0; i--) {
+        pnr[i] = DIGITS[value % 36];
+        value /= 36;
+    }
+    pnr[0] = static_cast<char>('A' + value);   // value < 26 is what remains
+    pnr[PNR_LENGTH] = '\0';
+    return true;
+}
+
+int PnrCodec::decode(const char* pnr) const {
+    int first = digitValue(pnr[0]);
+    if (first < 10) return -1;   // must start with a letter
+
+    std::uint64_t value = static_cast<std::uint64_t>(first - 10);
+    for (int i = 1; i < PNR_LENGTH; i++) {
+        int digit = digitValue(pnr[i]);
+        if (digit < 0) return -1;
+        value = value * 36 + static_cast<std::uint64_t>(digit);
+    }
+    if (pnr[PNR_LENGTH] != '\0') return -1;
+
+    std::uint64_t bookingId = ((value + SPACE - offset) % SPACE) * inverse % SPACE;
+    if (bookingId > 0x7FFFFFFFULL) return -1;
+    return static_cast<int>(bookingId);
+}
+
+std::uint64_t PnrCodec::modularInverse(std::uint64_t value, std::uint64_t modulus) {
+    // Extended Euclid on signed values; 0 when no inverse exists
+    long long r0 = static_cast<long long>(modulus), r1 = static_cast<long long>(value);
+    long long t0 = 0, t1 = 1;
+    while (r1 != 0) {
+        long long q = r0 / r1;
+        long long r2 = r0 - q * r1;
+        r0 = r1;
+        r1 = r2;
+        long long t2 = t0 - q * t1;
+        t0 = t1;
+        t1 = t2;
+    }
+    if (r0 != 1) return 0;
+    if (t0 < 0) t0 += static_cast<long long>(modulus);
+    return static_cast<std::uint64_t>(t0);
+}
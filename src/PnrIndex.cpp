@@ -0,0 +1,123 @@
+#include "PnrIndex.h"
+
+PnrIndex::PnrIndex() : slots(INITIAL_CAPACITY, Slot{0, -1}), count(0) {}
+
+PnrIndex::~PnrIndex() {}
+
+std::uint64_t PnrIndex::packKey(const char* pnr) {
+    // Up to 8 characters fit in the key; anything longer cannot be indexed
+    if (!pnr || pnr[0] == '\0') return 0;
+    std::uint64_t key = 0;
+    int i = 0;
+    while (pnr[i] != '\0') {
+        if (i == 8) return 0;
+        key = (key << 8) | static_cast<unsigned char>(pnr[i]);
+        i++;
+    }
+    return key;
+}
+
+int PnrIndex::homeSlot(std::uint64_t key) const {
+    // Fibonacci hashing spreads the mostly-alphanumeric bytes across the table
+    std::uint64_t hash = key * 0x9E3779B97F4A7C15ULL;
+    return static_cast<int>((hash >> 32) & (slots.size() - 1));
+}
+
+void PnrIndex::insert(const char* pnr, int bookingId) {
+    std::uint64_t key = packKey(pnr);
+    if (key == 0) return;
+
+    // Keep the load factor at or below one half
+    if ((count + 1) * 2 > static_cast<int>(slots.size())) {
+        rehash(static_cast<int>(slots.size()) * 2);
+    }
+
+    int mask = static_cast<int>(slots.size()) - 1;
+    int i = homeSlot(key);
+    while (slots[i].key != 0) {
+        if (slots[i].key == key) {
+            slots[i].bookingId = bookingId;
+            return;
+        }
+        i = (i + 1) & mask;
+    }
+    slots[i].key = key;
+    slots[i].bookingId = bookingId;
+    count++;
+}
+
+void PnrIndex::remove(const char* pnr, int bookingId) {
+    std::uint64_t key = packKey(pnr);
+    if (key == 0) return;
+
+    int mask = static_cast<int>(slots.size()) - 1;
+    int i = homeSlot(key);
+    while (slots[i].key != key) {
+        if (slots[i].key == 0) return;
+        i = (i + 1) & mask;
+    }
+    if (slots[i].bookingId != bookingId) return;
+
+    // Backward-shift deletion keeps probe chains intact without tombstones
+    int hole = i;
+    int j = (i + 1) & mask;
+    while (slots[j].key != 0) {
+        int home = homeSlot(slots[j].key);
+        // Move the entry back if its home slot is not within (hole, j]
+        if (((j - home) & mask) >= ((j - hole) & mask)) {
+            slots[hole] = slots[j];
+            hole = j;
+        }
+        j = (j + 1) & mask;
+    }
+    slots[hole].key = 0;
+    slots[hole].bookingId = -1;
+    count--;
+}
+
+int PnrIndex::find(const char* pnr) const {
+    std::uint64_t key = packKey(pnr);
+    if (key == 0) return -1;
+
+    int mask = static_cast<int>(slots.size()) - 1;
+    int i = homeSlot(key);
+    while (slots[i].key != 0) {
+        if (slots[i].key == key) return slots[i].bookingId;
+        i = (i + 1) & mask;
+    }
+    return -1;
+}
+
+void PnrIndex::clear() {
+    for (Slot& slot : slots) {
+        slot.key = 0;
+        slot.bookingId = -1;
+    }
+    count = 0;
+}
+
+void PnrIndex::reserve(int expected) {
+    int capacity = static_cast<int>(slots.size());
+    while (expected * 2 > capacity) capacity *= 2;
+    if (capacity > static_cast<int>(slots.size())) {
+        rehash(capacity);
+    }
+}
+
+int PnrIndex::size() const {
+    return count;
+}
+
+void PnrIndex::rehash(int newCapacity) {
+    std::vector<Slot> old;
+    old.swap(slots);
+    slots.assign(newCapacity, Slot{0, -1});
+
+    int mask = newCapacity - 1;
+    for (const Slot& slot : old) {
+        if (slot.key == 0) continue;
+        int i = homeSlot(slot.key);
+        while (slots[i].key != 0) i = (i + 1) & mask;
+        slots[i] = slot;
+    }
+}
@@ -0,0 +1,216 @@
+#include "PricingEngine.h"
+#include "Flight.h"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <nlohmann/json.hpp>
+
+#ifdef PRICING_HAVE_AVX2
+#include <immintrin.h>
+#endif
+
+const int PricingEngine::OCCUPANCY_STEPS;
+std::atomic<int> PricingEngine::nextGeneration(1);
+
+PricingEngine::PricingEngine() : taxes(45.50), generation(0) {
+    // Defaults match the rules the booking screens have always used
+    compile({{0.5, 0.10}, {0.6, 0.15}, {0.7, 0.25}, {0.8, 0.35}, {0.9, 0.50}},
+            {{1, 0.75}, {3, 0.50}, {7, 0.30}, {14, 0.20}, {21, 0.10}, {30, 0.05}});
+}
+
+PricingEngine::~PricingEngine() {}
+
+bool PricingEngine::loadFromFile(const char* filename) {
+    std::ifstream i(filename);
+    if (!i.is_open()) {
+        std::cout << "Pricing rules " << filename << " not found. Using default pricing." << std::endl;
+        return false;
+    }
+
+    try {
+        nlohmann::json j;
+        i >> j;
+
+        std::vector<DemandRule> demandRules;
+        for (const auto& rule : j.at("demandSurge")) {
+            demandRules.push_back(DemandRule{rule.at("minOccupancy").get<double>(), rule.at("surge").get<double>()});
+        }
+        std::vector<TimeRule> timeRules;
+        for (const auto& rule : j.at("timeSurge")) {
+            timeRules.push_back(TimeRule{rule.at("maxDays").get<int>(), rule.at("surge").get<double>()});
+        }
+
+        taxes = j.value("taxesAndFees", 45.50);
+        compile(demandRules, timeRules);
+    } catch (const nlohmann::json::exception& e) {
+        std::cout << "Invalid pricing rules in " << filename << ": " << e.what() << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void PricingEngine::compile(std::vector<DemandRule> demandRules, std::vector<TimeRule> timeRules) {
+    // Highest occupancy threshold reached wins
+    std::sort(demandRules.begin(), demandRules.end(),
+              [](const DemandRule& a, const DemandRule& b) { return a.minOccupancy < b.minOccupancy; });
+    demandByStep.assign(OCCUPANCY_STEPS + 1, 0.0);
+    for (const DemandRule& rule : demandRules) {
+        // Round the threshold so 0.7 means exactly 700 steps despite binary fractions
+        int first = static_cast<int>(rule.minOccupancy * OCCUPANCY_STEPS + 0.5);
+        first = std::max(0, std::min(first, OCCUPANCY_STEPS));
+        for (int step = first; step <= OCCUPANCY_STEPS; step++) {
+            demandByStep[step] = rule.surge;
+        }
+    }
+
+    // Tightest day limit that still covers the day wins
+    std::sort(timeRules.begin(), timeRules.end(),
+              [](const TimeRule& a, const TimeRule& b) { return a.maxDays > b.maxDays; });
+    int lastDay = timeRules.empty() ? 0 : std::max(timeRules.front().maxDays, 0);
+    timeByDay.assign(lastDay + 2, 0.0);   // the extra entry covers bookings further out
+    for (const TimeRule& rule : timeRules) {
+        for (int day = 0; day <= rule.maxDays && day <= lastDay; day++) {
+            timeByDay[day] = rule.surge;
+        }
+    }
+
+    // Bucket boundaries for cached quotes
+    demandRunStart.assign(OCCUPANCY_STEPS + 1, 0);
+    demandRunEnd.assign(OCCUPANCY_STEPS + 1, OCCUPANCY_STEPS);
+    for (int step = 1; step <= OCCUPANCY_STEPS; step++) {
+        demandRunStart[step] = demandByStep[step] == demandByStep[step - 1] ? demandRunStart[step - 1] : step;
+    }
+    for (int step = OCCUPANCY_STEPS - 1; step >= 0; step--) {
+        demandRunEnd[step] = demandByStep[step] == demandByStep[step + 1] ? demandRunEnd[step + 1] : step;
+    }
+    timeBucketByDay.assign(timeByDay.size(), 0);
+    for (size_t day = 1; day < timeByDay.size(); day++) {
+        timeBucketByDay[day] = timeBucketByDay[day - 1] + (timeByDay[day] != timeByDay[day - 1] ? 1 : 0);
+    }
+    generation = nextGeneration++;
+}
+
+int PricingEngine::occupancyStep(int totalSeats, int availableSeats) const {
+    int sold = std::max(0, std::min(totalSeats - availableSeats, totalSeats));
+    // Integer division: the step is reached exactly when occupancy meets the threshold
+    return static_cast<int>(static_cast<long long>(sold) * OCCUPANCY_STEPS / totalSeats);
+}
+
+double PricingEngine::demandRate(int totalSeats, int availableSeats) const {
+    if (totalSeats <= 0) return 0.0;
+    return demandByStep[occupancyStep(totalSeats, availableSeats)];
+}
+
+int PricingEngine::timeBucket(int daysUntilDeparture) const {
+    int last = static_cast<int>(timeBucketByDay.size()) - 1;
+    return timeBucketByDay[std::max(0, std::min(daysUntilDeparture, last))];
+}
+
+void PricingEngine::demandRange(int totalSeats, int availableSeats, int& minAvailable, int& maxAvailable) const {
+    minAvailable = std::numeric_limits<int>::min();
+    maxAvailable = std::numeric_limits<int>::max();
+    if (totalSeats <= 0) return;   // never surged, whatever the count
+
+    // Invert step = sold * STEPS / total over the run of equal surges. Sold
+    // counts are clamped to [0, total], so the outermost runs are open-ended.
+    int step = occupancyStep(totalSeats, availableSeats);
+    long long first = demandRunStart[step], last = demandRunEnd[step];
+    if (first > 0) {
+        long long minSold = (first * totalSeats + OCCUPANCY_STEPS - 1) / OCCUPANCY_STEPS;
+        maxAvailable = static_cast<int>(totalSeats - minSold);
+    }
+    if (last < OCCUPANCY_STEPS) {
+        long long maxSold = ((last + 1) * totalSeats - 1) / OCCUPANCY_STEPS;
+        minAvailable = static_cast<int>(totalSeats - maxSold);
+    }
+}
+
+double PricingEngine::timeRate(int daysUntilDeparture) const {
+    int last = static_cast<int>(timeByDay.size()) - 1;
+    int day = std::max(0, std::min(daysUntilDeparture, last));
+    return timeByDay[day];
+}
+
+PriceQuote PricingEngine::quote(const Flight& flight, int daysUntilDeparture) const {
+    return quote(flight.getBasePrice(), flight.getTotalSeats(), flight.getAvailableSeats(), daysUntilDeparture);
+}
+
+PriceQuote PricingEngine::quote(double basePrice, int totalSeats, int availableSeats, int daysUntilDeparture) const {
+    PriceQuote q;
+    q.baseFare = basePrice;
+    q.demandSurge = basePrice * demandRate(totalSeats, availableSeats);
+    q.timeSurge = basePrice * timeRate(daysUntilDeparture);
+    q.fare = basePrice + q.demandSurge + q.timeSurge;
+    q.taxes = taxes;
+    q.total = q.fare + q.taxes;
+    return q;
+}
+
+bool PricingEngine::usesAvx2() {
+#ifdef PRICING_HAVE_AVX2
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+#else
+    return false;
+#endif
+}
+
+void PricingEngine::quoteFares(const double* basePrices, const int* totalSeats, const int* availableSeats,
+                               const int* daysUntilDeparture, int count, double* fares) const {
+#ifdef PRICING_HAVE_AVX2
+    if (usesAvx2()) {
+        quoteFaresAvx2(basePrices, totalSeats, availableSeats, daysUntilDeparture, count, fares);
+        return;
+    }
+#endif
+    quoteFaresScalar(basePrices, totalSeats, availableSeats, daysUntilDeparture, count, fares);
+}
+
+void PricingEngine::quoteFaresScalar(const double* basePrices, const int* totalSeats, const int* availableSeats,
+                                     const int* daysUntilDeparture, int count, double* fares) const {
+    for (int i = 0; i < count; i++) {
+        fares[i] = quote(basePrices[i], totalSeats[i], availableSeats[i], daysUntilDeparture[i]).total;
+    }
+}
+
+#ifdef PRICING_HAVE_AVX2
+__attribute__((target("avx2")))
+void PricingEngine::quoteFaresAvx2(const double* basePrices, const int* totalSeats, const int* availableSeats,
+                                   const int* daysUntilDeparture, int count, double* fares) const {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i one = _mm_set1_epi32(1);
+    const __m128i lastDay = _mm_set1_epi32(static_cast<int>(timeByDay.size()) - 1);
+    const __m256d steps = _mm256_set1_pd(OCCUPANCY_STEPS);
+    const __m256d taxRate = _mm256_set1_pd(taxes);
+    const __m256d allLanes = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+
+    // Four flights per iteration, same arithmetic and order as quote()
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128i total = _mm_loadu_si128(reinterpret_cast<const __m128i*>(totalSeats + i));
+        __m128i available = _mm_loadu_si128(reinterpret_cast<const __m128i*>(availableSeats + i));
+        __m128i days = _mm_loadu_si128(reinterpret_cast<const __m128i*>(daysUntilDeparture + i));
+        __m256d base = _mm256_loadu_pd(basePrices + i);
+
+        // Occupancy step. The quotient of two ints below 2^31 never rounds up to
+        // the next integer in double, so truncating matches integer division.
+        __m128i hasSeats = _mm_cmpgt_epi32(total, zero);
+        __m128i safeTotal = _mm_max_epi32(total, one);
+        __m128i sold = _mm_min_epi32(_mm_max_epi32(_mm_sub_epi32(total, available), zero), safeTotal);
+        __m256d ratio = _mm256_div_pd(_mm256_mul_pd(_mm256_cvtepi32_pd(sold), steps), _mm256_cvtepi32_pd(safeTotal));
+        __m128i step = _mm256_cvttpd_epi32(ratio);
+        // Flights without seats are masked out and get no demand surge
+        __m256d seatMask = _mm256_castsi256_pd(_mm256_cvtepi32_epi64(hasSeats));
+        __m256d demand = _mm256_mask_i32gather_pd(_mm256_setzero_pd(), demandByStep.data(), step, seatMask, 8);
+
+        __m128i day = _mm_min_epi32(_mm_max_epi32(days, zero), lastDay);
+        __m256d time = _mm256_mask_i32gather_pd(_mm256_setzero_pd(), timeByDay.data(), day, allLanes, 8);
+
+        __m256d fare = _mm256_add_pd(base, _mm256_mul_pd(base, demand));
+        fare = _mm256_add_pd(fare, _mm256_mul_pd(base, time));
+        _mm256_storeu_pd(fares + i, _mm256_add_pd(fare, taxRate));
+    }
+    quoteFaresScalar(basePrices + i, totalSeats + i, availableSeats + i, daysUntilDeparture + i, count - i, fares + i);
+}
+#endif
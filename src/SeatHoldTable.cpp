@@ -0,0 +1,106 @@
+#include "SeatHoldTable.h"
+#include "SeatOccupancy.h"
+#include "StringUtils.h"
+#include <ctime>
+
+SeatHoldTable::SeatHoldTable() : expiries(static_cast<long long>(time(nullptr))) {}
+
+SeatHoldTable::~SeatHoldTable() {}
+
+bool SeatHoldTable::place(std::uint64_t holdId, const char* flightNumber, const char* seatNumber,
+                          long long expiresAt, long long now) {
+    int row, column;
+    if (holdId == 0 || !SeatOccupancy::parseSeat(seatNumber, row, column)) return false;
+    expire(now);
+
+    std::string key = seatKey(flightNumber, row, column);
+    auto bySeat = holdBySeat.find(key);
+    if (bySeat != holdBySeat.end() && bySeat->second != holdId) {
+        auto other = holds.find(bySeat->second);
+        if (other != holds.end() && other->second.expiresAt > now) return false;
+        if (other != holds.end()) erase(other);
+    }
+
+    // A hold covers one seat; moving it frees the old one
+    auto existing = holds.find(holdId);
+    if (existing != holds.end()) erase(existing);
+
+    SeatHold hold;
+    hold.holdId = holdId;
+    copyString(hold.flightNumber, flightNumber, sizeof(hold.flightNumber));
+    copyString(hold.seatNumber, seatNumber, sizeof(hold.seatNumber));
+    hold.expiresAt = expiresAt;
+    holds[holdId] = hold;
+    holdBySeat[key] = holdId;
+    expiries.schedule(holdId, expiresAt);
+    return true;
+}
+
+void SeatHoldTable::release(std::uint64_t holdId) {
+    auto it = holds.find(holdId);
+    if (it != holds.end()) erase(it);
+}
+
+void SeatHoldTable::releaseSeat(const char* flightNumber, const char* seatNumber) {
+    int row, column;
+    if (holds.empty() || !SeatOccupancy::parseSeat(seatNumber, row, column)) return;
+
+    auto bySeat = holdBySeat.find(seatKey(flightNumber, row, column));
+    if (bySeat != holdBySeat.end()) release(bySeat->second);
+}
+
+const SeatHold* SeatHoldTable::find(std::uint64_t holdId, long long now) const {
+    auto it = holds.find(holdId);
+    if (it == holds.end() || it->second.expiresAt <= now) return nullptr;
+    return &it->second;
+}
+
+std::uint64_t SeatHoldTable::holderOf(const char* flightNumber, int row, int column, long long now) const {
+    if (holds.empty()) return 0;
+    auto bySeat = holdBySeat.find(seatKey(flightNumber, row, column));
+    if (bySeat == holdBySeat.end()) return 0;
+    return find(bySeat->second, now) ? bySeat->second : 0;
+}
+
+void SeatHoldTable::expire(long long now) {
+    expired.clear();
+    expiries.advance(now, expired);
+    for (const TimerWheel::Timer& timer : expired) {
+        // Released or extended holds leave stale timers behind
+        auto it = holds.find(timer.id);
+        if (it != holds.end() && it->second.expiresAt <= now) {
+            erase(it);
+        }
+    }
+}
+
+void SeatHoldTable::collectLive(std::vector<SeatHold>& out, long long now) const {
+    for (const auto& entry : holds) {
+        if (entry.second.expiresAt > now) out.push_back(entry.second);
+    }
+}
+
+void SeatHoldTable::clear() {
+    holds.clear();
+    holdBySeat.clear();
+    expiries.clear();
+}
+
+void SeatHoldTable::erase(std::unordered_map<std::uint64_t, SeatHold>::iterator it) {
+    int row, column;
+    if (SeatOccupancy::parseSeat(it->second.seatNumber, row, column)) {
+        std::string key = seatKey(it->second.flightNumber, row, column);
+        auto bySeat = holdBySeat.find(key);
+        if (bySeat != holdBySeat.end() && bySeat->second == it->first) {
+            holdBySeat.erase(bySeat);
+        }
+    }
+    holds.erase(it);
+}
+
+std::string SeatHoldTable::seatKey(const char* flightNumber, int row, int column) {
+    std::string key(flightNumber);
+    key += '#';
+    key += std::to_string((row - 1) * SeatOccupancy::SEATS_PER_ROW + column);
+    return key;
+}
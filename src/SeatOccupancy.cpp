@@ -0,0 +1,116 @@
+#include "SeatOccupancy.h"
+#include <bit>
+#include <cstring>
+
+SeatOccupancy::SeatOccupancy() {}
+
+SeatOccupancy::~SeatOccupancy() {}
+
+bool SeatOccupancy::parseSeat(const char* seatNumber, int& row, int& column) {
+    if (!seatNumber) return false;
+    int len = static_cast<int>(strlen(seatNumber));
+    if (len < 2 || len > 3) return false;
+
+    char letter = seatNumber[len - 1];
+    if (letter < 'A' || letter >= 'A' + SEATS_PER_ROW) return false;
+
+    row = 0;
+    for (int i = 0; i < len - 1; i++) {
+        if (seatNumber[i] < '0' || seatNumber[i] > '9') return false;
+        row = row * 10 + (seatNumber[i] - '0');
+    }
+    if (row < 1 || row > MAX_ROWS) return false;
+
+    column = letter - 'A';
+    return true;
+}
+
+void SeatOccupancy::occupy(const char* flightNumber, const char* seatNumber) {
+    int row, column;
+    if (!parseSeat(seatNumber, row, column)) return;
+
+    auto it = flights.find(flightNumber);
+    if (it == flights.end()) {
+        FlightSeats empty;
+        std::memset(empty.words, 0, sizeof(empty.words));
+        it = flights.emplace(flightNumber, empty).first;
+    }
+
+    int bit = (row - 1) * SEATS_PER_ROW + column;
+    std::uint64_t mask = std::uint64_t(1) << (bit & 63);
+    std::uint64_t& word = it->second.words[bit >> 6];
+    if (word & mask) {
+        duplicateHolders[duplicateKey(flightNumber, bit)]++;
+    } else {
+        word |= mask;
+    }
+}
+
+void SeatOccupancy::release(const char* flightNumber, const char* seatNumber) {
+    int row, column;
+    if (!parseSeat(seatNumber, row, column)) return;
+
+    auto it = flights.find(flightNumber);
+    if (it == flights.end()) return;
+
+    int bit = (row - 1) * SEATS_PER_ROW + column;
+    if (!duplicateHolders.empty()) {
+        auto dup = duplicateHolders.find(duplicateKey(flightNumber, bit));
+        if (dup != duplicateHolders.end()) {
+            if (--dup->second == 0) duplicateHolders.erase(dup);
+            return;
+        }
+    }
+    it->second.words[bit >> 6] &= ~(std::uint64_t(1) << (bit & 63));
+}
+
+bool SeatOccupancy::isOccupied(const char* flightNumber, const char* seatNumber) const {
+    int row, column;
+    if (!parseSeat(seatNumber, row, column)) return false;
+    return isOccupied(flightNumber, row, column);
+}
+
+bool SeatOccupancy::isOccupied(const char* flightNumber, int row, int column) const {
+    if (row < 1 || row > MAX_ROWS || column < 0 || column >= SEATS_PER_ROW) return false;
+
+    const FlightSeats* seats = findFlight(flightNumber);
+    if (!seats) return false;
+
+    int bit = (row - 1) * SEATS_PER_ROW + column;
+    return (seats->words[bit >> 6] >> (bit & 63)) & 1;
+}
+
+int SeatOccupancy::getOccupiedCount(const char* flightNumber) const {
+    const FlightSeats* seats = findFlight(flightNumber);
+    if (!seats) return 0;
+
+    int count = 0;
+    for (int i = 0; i < WORD_COUNT; i++) {
+        count += std::popcount(seats->words[i]);
+    }
+    return count;
+}
+
+void SeatOccupancy::copyWords(const char* flightNumber, std::uint64_t* words) const {
+    const FlightSeats* seats = findFlight(flightNumber);
+    for (int i = 0; i < WORD_COUNT; i++) {
+        words[i] = seats ? seats->words[i] : 0;
+    }
+}
+
+void SeatOccupancy::clear() {
+    flights.clear();
+    duplicateHolders.clear();
+}
+
+const SeatOccupancy::FlightSeats* SeatOccupancy::findFlight(const char* flightNumber) const {
+    auto it = flights.find(flightNumber);
+    return it != flights.end() ? &it->second : nullptr;
+}
+
+std::string SeatOccupancy::duplicateKey(const char* flightNumber, int bit) {
+    std::string key(flightNumber);
+    key += '#';
+    key += std::to_string(bit);
+    return key;
+}
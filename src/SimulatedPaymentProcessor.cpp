@@ -0,0 +1,169 @@
+#include "SimulatedPaymentProcessor.h"
+#include "StringUtils.h"
+#include <cstdio>
+
+const int SimulatedPaymentProcessor::REFUND_WINDOW_MINUTES;
+
+SimulatedPaymentProcessor::SimulatedPaymentProcessor(int latencyMs, double failureRate)
+    : stopping(false), nextSequence(0), nextTransactionNumber(100001), random(std::random_device()()),
+      latencyMs(latencyMs < 0 ? 0 : latencyMs), failureRate(failureRate) {
+    timerThread = std::thread(&SimulatedPaymentProcessor::timerLoop, this);
+}
+
+SimulatedPaymentProcessor::~SimulatedPaymentProcessor() {
+    {
+        std::lock_guard<std::mutex> guard(stateMutex);
+        stopping = true;
+    }
+    changed.notify_all();
+    timerThread.join();
+}
+
+void SimulatedPaymentProcessor::submit(const PaymentRequest& request, PaymentCallback onComplete) {
+    ScheduledPayment payment;
+    payment.onComplete = std::move(onComplete);
+    bool rejected;
+    {
+        std::lock_guard<std::mutex> guard(stateMutex);
+        rejected = stopping;
+        if (!rejected) {
+            bool approved = request.amount > 0.0 &&
+                            std::uniform_real_distribution<double>(0.0, 1.0)(random) >= failureRate;
+            payment.result.approved = approved;
+            snprintf(payment.result.transactionId, sizeof(payment.result.transactionId), "TXN%llu",
+                     static_cast<unsigned long long>(nextTransactionNumber++));
+            copyString(payment.result.message, approved ? "Payment approved" : "Payment declined by issuer",
+                       sizeof(payment.result.message));
+
+            auto now = std::chrono::steady_clock::now();
+            expireRefundable(now);
+            if (approved) {
+                refundable[payment.result.transactionId] = request.amount;
+                refundDeadlines.emplace_back(now + std::chrono::minutes(REFUND_WINDOW_MINUTES),
+                                             payment.result.transactionId);
+            }
+            schedule(payment);
+        }
+    }
+
+    if (rejected) {
+        rejectWhileStopping(payment);
+        return;
+    }
+    changed.notify_one();
+}
+
+void SimulatedPaymentProcessor::refund(const char* transactionId, double amount, PaymentCallback onComplete) {
+    ScheduledPayment payment;
+    payment.onComplete = std::move(onComplete);
+    bool rejected;
+    {
+        std::lock_guard<std::mutex> guard(stateMutex);
+        rejected = stopping;
+        if (!rejected) {
+            // Never more than what is left of an approved payment
+            expireRefundable(std::chrono::steady_clock::now());
+            auto it = refundable.find(transactionId ? transactionId : "");
+            bool approved = it != refundable.end() && amount > 0.0 && amount <= it->second + 0.005;
+            if (approved) {
+                it->second -= amount;
+                if (it->second <= 0.005) refundable.erase(it);
+            }
+            payment.result.approved = approved;
+            copyString(payment.result.transactionId, transactionId ? transactionId : "",
+                       sizeof(payment.result.transactionId));
+            copyString(payment.result.message, approved ? "Refund approved" : "No matching payment to refund",
+                       sizeof(payment.result.message));
+            schedule(payment);
+        }
+    }
+
+    if (rejected) {
+        rejectWhileStopping(payment);
+        return;
+    }
+    changed.notify_one();
+}
+
+void SimulatedPaymentProcessor::settle(const char* transactionId) {
+    std::lock_guard<std::mutex> guard(stateMutex);
+    if (transactionId) {
+        // The deadline entry stays queued and finds nothing to erase when it runs out
+        refundable.erase(transactionId);
+    }
+}
+
+void SimulatedPaymentProcessor::setLatency(int latencyMs) {
+    std::lock_guard<std::mutex> guard(stateMutex);
+    this->latencyMs = latencyMs < 0 ? 0 : latencyMs;
+}
+
+void SimulatedPaymentProcessor::setFailureRate(double failureRate) {
+    std::lock_guard<std::mutex> guard(stateMutex);
+    this->failureRate = failureRate;
+}
+
+int SimulatedPaymentProcessor::getInFlightCount() {
+    std::lock_guard<std::mutex> guard(stateMutex);
+    return static_cast<int>(pending.size());
+}
+
+int SimulatedPaymentProcessor::getRefundableCount() {
+    std::lock_guard<std::mutex> guard(stateMutex);
+    return static_cast<int>(refundable.size());
+}
+
+// Private helpers
+void SimulatedPaymentProcessor::schedule(ScheduledPayment& payment) {
+    // Caller holds stateMutex
+    payment.due = std::chrono::steady_clock::now() + std::chrono::milliseconds(latencyMs);
+    payment.sequence = nextSequence++;
+    pending.push(std::move(payment));
+}
+
+void SimulatedPaymentProcessor::rejectWhileStopping(ScheduledPayment& payment) {
+    // Submitted after shutdown began: decline at once
+    payment.result.approved = false;
+    payment.result.transactionId[0] = '\0';
+    copyString(payment.result.message, "Payment processor is shutting down", sizeof(payment.result.message));
+    payment.onComplete(payment.result);
+}
+
+void SimulatedPaymentProcessor::expireRefundable(std::chrono::steady_clock::time_point now) {
+    // Caller holds stateMutex. Deadlines are queued in order, since the window never changes.
+    while (!refundDeadlines.empty() && refundDeadlines.front().first <= now) {
+        refundable.erase(refundDeadlines.front().second);
+        refundDeadlines.pop_front();
+    }
+}
+
+void SimulatedPaymentProcessor::timerLoop() {
+    std::vector<ScheduledPayment> due;
+    std::unique_lock<std::mutex> guard(stateMutex);
+    while (true) {
+        if (pending.empty()) {
+            if (stopping) break;
+            changed.wait(guard);
+            continue;
+        }
+
+        // On shutdown every pending payment completes at once
+        auto now = std::chrono::steady_clock::now();
+        if (!stopping && pending.top().due > now) {
+            changed.wait_until(guard, pending.top().due);
+            continue;
+        }
+        while (!pending.empty() && (stopping || pending.top().due <= now)) {
+            due.push_back(std::move(const_cast<ScheduledPayment&>(pending.top())));
+            pending.pop();
+        }
+
+        // Callbacks run without the lock so they may submit further payments
+        guard.unlock();
+        for (ScheduledPayment& payment : due) {
+            payment.onComplete(payment.result);
+        }
+        due.clear();
+        guard.lock();
+    }
+}
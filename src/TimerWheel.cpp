@@ -0,0 +1,111 @@
+#include "TimerWheel.h"
+
+TimerWheel::TimerWheel(long long startTick) : currentTick(startTick), count(0) {
+    for (int level = 0; level < LEVELS; level++) {
+        levelCounts[level] = 0;
+    }
+}
+
+TimerWheel::~TimerWheel() {}
+
+void TimerWheel::schedule(std::uint64_t id, long long expiryTick) {
+    Timer timer = {id, expiryTick};
+    if (expiryTick <= currentTick) {
+        overdue.push_back(timer);
+        count++;
+        return;
+    }
+    place(timer);
+    count++;
+}
+
+void TimerWheel::place(const Timer& timer) {
+    // Lowest level whose range still covers the expiry
+    long long delta = timer.expiryTick - currentTick;
+    int level = 0;
+    while (level < LEVELS - 1 && delta >= (1LL << (SLOT_BITS * (level + 1)))) {
+        level++;
+    }
+
+    // Beyond the top level: park in the farthest top slot and re-place on cascade
+    long long tick = timer.expiryTick;
+    long long horizon = currentTick + (1LL << (SLOT_BITS * LEVELS)) - 1;
+    if (tick > horizon) tick = horizon;
+
+    int slot = static_cast<int>((tick >> (SLOT_BITS * level)) & (SLOTS - 1));
+    slots[level][slot].push_back(timer);
+    levelCounts[level]++;
+}
+
+void TimerWheel::cascade(int level) {
+    int slot = static_cast<int>((currentTick >> (SLOT_BITS * level)) & (SLOTS - 1));
+    std::vector<Timer> moving;
+    moving.swap(slots[level][slot]);
+    levelCounts[level] -= static_cast<int>(moving.size());
+    for (const Timer& timer : moving) {
+        if (timer.expiryTick <= currentTick) {
+            overdue.push_back(timer);
+        } else {
+            place(timer);
+        }
+    }
+}
+
+void TimerWheel::step(std::vector<Timer>& expired) {
+    currentTick++;
+
+    // Refill the lower levels when their index wraps, highest level first
+    int wrapped = 0;
+    while (wrapped < LEVELS - 1 &&
+           ((currentTick >> (SLOT_BITS * wrapped)) & (SLOTS - 1)) == 0) {
+        wrapped++;
+    }
+    for (int level = wrapped; level > 0; level--) {
+        cascade(level);
+    }
+
+    int slot = static_cast<int>(currentTick & (SLOTS - 1));
+    std::vector<Timer>& due = slots[0][slot];
+    levelCounts[0] -= static_cast<int>(due.size());
+    count -= static_cast<int>(due.size());
+    expired.insert(expired.end(), due.begin(), due.end());
+    due.clear();
+}
+
+void TimerWheel::advance(long long nowTick, std::vector<Timer>& expired) {
+    while (currentTick < nowTick) {
+        if (count == static_cast<int>(overdue.size())) {
+            currentTick = nowTick;
+            break;
+        }
+
+        // Nothing fires before the next boundary of the lowest non-empty level
+        int level = 0;
+        while (levelCounts[level] == 0) level++;
+        if (level > 0) {
+            long long span = 1LL << (SLOT_BITS * level);
+            long long lastQuietTick = (currentTick / span + 1) * span - 1;
+            if (lastQuietTick >= nowTick) {
+                currentTick = nowTick;
+                break;
+            }
+            currentTick = lastQuietTick;
+        }
+        step(expired);
+    }
+
+    count -= static_cast<int>(overdue.size());
+    expired.insert(expired.end(), overdue.begin(), overdue.end());
+    overdue.clear();
+}
+
+void TimerWheel::clear() {
+    for (int level = 0; level < LEVELS; level++) {
+        for (int slot = 0; slot < SLOTS; slot++) {
+            slots[level][slot].clear();
+        }
+        levelCounts[level] = 0;
+    }
+    overdue.clear();
+    count = 0;
+}
@@ -0,0 +1,193 @@
+// Stress test for the concurrent booking path: many threads race for every
+// seat of one flight and no seat may ever be booked twice.
+//
+// Phase 1 hammers AtomicSeatMap directly: every thread tries to claim every
+// seat, and each seat must be won exactly once. Phase 2 runs the same race
+// through BookingEngine, checks the results the callers got back, and then
+// checks the bookings as stored on disk.
+//
+// Runs in a scratch directory under the working directory and reports on
+// std::cerr; exits non-zero on any double booking.
+
+#include "AtomicSeatMap.h"
+#include "BookingEngine.h"
+#include "BookingManager.h"
+#include "FileLock.h"
+#include "FlightList.h"
+#include "LockStripes.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <filesystem>
+#include <future>
+#include <iostream>
+#include <random>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+static const int THREAD_COUNT = 16;
+static const int ROWS = 30;
+static const int SEAT_COUNT = ROWS * SeatOccupancy::SEATS_PER_ROW;
+static const char* FLIGHT_NUMBER = "ST100";
+
+static int failures = 0;
+
+static void check(bool condition, const std::string& message) {
+    if (!condition) {
+        std::cerr << "FAILED: " << message << std::endl;
+        failures++;
+    }
+}
+
+static std::vector<std::string> allSeats() {
+    std::vector<std::string> seats;
+    for (int row = 1; row <= ROWS; row++) {
+        for (int column = 0; column < SeatOccupancy::SEATS_PER_ROW; column++) {
+            seats.push_back(std::to_string(row) + static_cast<char>('A' + column));
+        }
+    }
+    return seats;
+}
+
+static void raceSeatClaims() {
+    AtomicSeatMap claims;
+    std::uint64_t empty[SeatOccupancy::WORD_COUNT] = {};
+    claims.addFlight(FLIGHT_NUMBER, empty);
+
+    std::vector<std::string> seats = allSeats();
+    std::vector<std::atomic<int>> winners(SEAT_COUNT);
+    for (auto& count : winners) count = 0;
+
+    const int rounds = 200;
+    for (int round = 0; round < rounds; round++) {
+        std::vector<std::thread> threads;
+        for (int t = 0; t < THREAD_COUNT; t++) {
+            threads.emplace_back([&, t] {
+                std::vector<int> order(SEAT_COUNT);
+                for (int i = 0; i < SEAT_COUNT; i++) order[i] = i;
+                std::shuffle(order.begin(), order.end(), std::mt19937(round * THREAD_COUNT + t));
+                for (int i : order) {
+                    if (claims.tryClaim(FLIGHT_NUMBER, seats[i].c_str())) winners[i]++;
+                }
+            });
+        }
+        for (std::thread& thread : threads) thread.join();
+
+        // Every seat won exactly once this round, then freed for the next
+        for (int i = 0; i < SEAT_COUNT; i++) {
+            check(winners[i] == round + 1, "seat " + seats[i] + " claimed " + std::to_string(winners[i]) +
+                                               " times after round " + std::to_string(round + 1));
+            claims.release(FLIGHT_NUMBER, seats[i].c_str());
+        }
+        if (failures > 0) return;
+    }
+    std::cerr << "AtomicSeatMap: " << rounds << " rounds of " << THREAD_COUNT << " threads x "
+              << SEAT_COUNT << " seats, every seat claimed exactly once per round" << std::endl;
+}
+
+static void raceBookingEngine() {
+    FlightList setup;
+    setup.addFlight(Flight("Stress Air", FLIGHT_NUMBER, "DEL", "BOM", "08:00", "10:00", "2027-01-01",
+                           "2027-01-01", "A320", 100.0, SEAT_COUNT, SEAT_COUNT));
+    setup.saveFlightsToFile("data/flights.json");
+
+    std::vector<std::string> seats = allSeats();
+    std::vector<std::vector<BookingResult>> results(THREAD_COUNT);
+    {
+        FileLock globalLock("data/bookings.lock");
+        LockStripes flightLocks("data/locks");
+        BookingManager bookingManager;
+        FlightList flightList;
+        bookingManager.setStorageLock(&globalLock);
+        bookingManager.loadBookingsFromFile("data/bookings.json");
+
+        BookingEngine engine(bookingManager, flightList, globalLock, flightLocks, 8);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < THREAD_COUNT; t++) {
+            threads.emplace_back([&, t] {
+                std::vector<int> order(SEAT_COUNT);
+                for (int i = 0; i < SEAT_COUNT; i++) order[i] = i;
+                std::shuffle(order.begin(), order.end(), std::mt19937(1000 + t));
+
+                std::vector<std::future<BookingResult>> futures;
+                for (int i : order) {
+                    BookingRequest request = {};
+                    std::snprintf(request.passengerName, sizeof(request.passengerName), "Thread %d", t);
+                    std::snprintf(request.flightNumber, sizeof(request.flightNumber), "%s", FLIGHT_NUMBER);
+                    std::snprintf(request.seatNumber, sizeof(request.seatNumber), "%s", seats[i].c_str());
+                    std::snprintf(request.cabinClass, sizeof(request.cabinClass), "economy");
+                    futures.push_back(engine.submit(request));
+                }
+                for (auto& future : futures) results[t].push_back(future.get());
+            });
+        }
+        for (std::thread& thread : threads) thread.join();
+        engine.shutdown();
+
+        // What the callers were told
+        int bookedCount = 0;
+        std::set<int> bookingIds;
+        for (const auto& threadResults : results) {
+            for (const BookingResult& result : threadResults) {
+                check(result.status == BookingResult::BOOKED || result.status == BookingResult::SEAT_TAKEN,
+                      "unexpected booking status " + std::to_string(result.status));
+                if (result.status == BookingResult::BOOKED) {
+                    bookedCount++;
+                    check(bookingIds.insert(result.bookingId).second,
+                          "booking ID " + std::to_string(result.bookingId) + " returned twice");
+                }
+            }
+        }
+        check(bookedCount == SEAT_COUNT, "expected " + std::to_string(SEAT_COUNT) + " bookings, callers got " +
+                                             std::to_string(bookedCount));
+    }
+
+    // What was stored: each seat held by exactly one booking, also after a reload from disk
+    BookingManager reloaded;
+    reloaded.loadBookingsFromFile("data/bookings.json");
+    std::set<std::string> bookedSeats;
+    int stored = 0;
+    for (int i = 0; i < reloaded.getBookingCount(); i++) {
+        const Booking* booking = reloaded.getBooking(i);
+        stored++;
+        check(bookedSeats.insert(booking->getSeatNumber()).second,
+              std::string("seat ") + booking->getSeatNumber() + " is stored twice");
+    }
+    check(stored == SEAT_COUNT, "expected " + std::to_string(SEAT_COUNT) + " stored bookings, found " +
+                                    std::to_string(stored));
+
+    FlightList catalog;
+    catalog.loadFlightsFromFile("data/flights.json");
+    const Flight* flight = catalog.getFlightByNumber(FLIGHT_NUMBER);
+    check(flight && flight->getAvailableSeats() == 0, "flight should be sold out");
+
+    std::cerr << "BookingEngine: " << THREAD_COUNT << " threads x " << SEAT_COUNT << " seats, "
+              << stored << " bookings stored, no seat booked twice" << std::endl;
+}
+
+int main() {
+    const std::filesystem::path scratch = "double_booking_stress_data";
+    std::filesystem::remove_all(scratch);
+    std::filesystem::create_directories(scratch / "data" / "locks");
+    std::filesystem::path previous = std::filesystem::current_path();
+    std::filesystem::current_path(scratch);
+
+    // The booking code reports every step on std::cout; the test reports on std::cerr
+    std::streambuf* console = std::cout.rdbuf(nullptr);
+    raceSeatClaims();
+    if (failures == 0) {
+        raceBookingEngine();
+    }
+    std::cout.rdbuf(console);
+
+    std::filesystem::current_path(previous);
+    std::filesystem::remove_all(scratch);
+    if (failures > 0) {
+        std::cerr << failures << " check(s) failed" << std::endl;
+        return 1;
+    }
+    std::cerr << "No seat was booked twice." << std::endl;
+    return 0;
+}
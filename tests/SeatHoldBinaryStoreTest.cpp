@@ -0,0 +1,106 @@
+// Seat holds with the binary booking store. The store does not persist
+// holds, so they live only in the process that placed them and must
+// survive every reload of the store, including the full reload taken when
+// another process has written more changes than the store's change log keeps.
+//
+// Runs in a scratch directory under the working directory and reports on
+// std::cerr; exits non-zero on any failed check.
+
+#include "BinaryBookingStore.h"
+#include "BookingManager.h"
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+#include <string>
+
+static const char* STORE_PATH = "data/bookings.bin";
+static const char* FLIGHT_NUMBER = "SH100";
+static const int HOLD_SECONDS = 600;
+
+static int failures = 0;
+
+static void check(bool condition, const std::string& message) {
+    if (!condition) {
+        std::cerr << "FAILED: " << message << std::endl;
+        failures++;
+    }
+}
+
+static int book(BookingManager& manager, const char* flightNumber, const char* seatNumber) {
+    return manager.createBooking("Other Process", flightNumber, "DEL", "BOM", "2027-01-01", "08:00",
+                                 seatNumber, "economy", 100.0);
+}
+
+static void holdTwoSeats() {
+    BookingManager holder;
+    check(holder.loadBookingsFromFile(STORE_PATH), "holder could not open the binary store");
+
+    std::uint64_t firstHold = holder.placeSeatHold(FLIGHT_NUMBER, "1A", HOLD_SECONDS, 0);
+    check(firstHold != 0, "first hold on 1A was not placed");
+
+    // Another process writes more changes than the change log keeps, so the
+    // holder's next catch-up falls back to a full reload of the store
+    BookingManager other;
+    check(other.loadBookingsFromFile(STORE_PATH), "second manager could not open the binary store");
+    int otherBookings = BOOKING_STORE_CHANGE_LOG_SIZE + 100;
+    for (int i = 0; i < otherBookings; i++) {
+        char flightNumber[10];
+        char seatNumber[5];
+        std::snprintf(flightNumber, sizeof(flightNumber), "OT%d", i / 180);
+        std::snprintf(seatNumber, sizeof(seatNumber), "%d%c", (i % 180) / 6 + 1, 'A' + i % 6);
+        if (book(other, flightNumber, seatNumber) == -1) {
+            check(false, std::string("could not book ") + flightNumber + " " + seatNumber);
+            return;
+        }
+    }
+
+    std::uint64_t secondHold = holder.placeSeatHold(FLIGHT_NUMBER, "1B", HOLD_SECONDS, 0);
+    check(secondHold != 0 && secondHold != firstHold, "second hold on 1B was not placed");
+    check(holder.getBookingCount() == otherBookings, "holder did not pick up the other process's bookings");
+    check(holder.isSeatHoldActive(firstHold), "first hold was lost by the full reload");
+    check(holder.isSeatHoldActive(secondHold), "second hold is not active");
+    check(holder.placeSeatHold(FLIGHT_NUMBER, "1A", HOLD_SECONDS, 0) == 0, "1A could be held twice");
+    check(!holder.isSeatAvailable(FLIGHT_NUMBER, "1B", firstHold), "1B is available to another hold");
+    check(holder.isSeatAvailable(FLIGHT_NUMBER, "1B", secondHold), "1B is not available to its own hold");
+
+    // An explicit reload keeps them too
+    check(holder.loadBookingsFromFile(STORE_PATH), "holder could not reload the binary store");
+    check(holder.isSeatHoldActive(firstHold) && holder.isSeatHoldActive(secondHold),
+          "holds were lost by an explicit reload");
+
+    // A seat another process books is gone, so its hold goes with it
+    other.refreshBookings();
+    check(book(other, FLIGHT_NUMBER, "1A") != -1, "other process could not book 1A");
+    holder.reloadBookings();
+    check(!holder.isSeatHoldActive(firstHold), "hold on 1A outlived the booking of 1A");
+    check(holder.isSeatHoldActive(secondHold), "hold on 1B was dropped with the hold on 1A");
+
+    holder.releaseSeatHold(secondHold);
+    check(!holder.isSeatHoldActive(secondHold), "released hold is still active");
+
+    std::cerr << "Binary store: two holds kept across " << otherBookings
+              << " bookings by another process and a full reload" << std::endl;
+}
+
+int main() {
+    const std::filesystem::path scratch = "seat_hold_binary_store_data";
+    std::filesystem::remove_all(scratch);
+    std::filesystem::create_directories(scratch / "data");
+    std::filesystem::path previous = std::filesystem::current_path();
+    std::filesystem::current_path(scratch);
+
+    // The booking code reports every step on std::cout; the test reports on std::cerr
+    std::streambuf* console = std::cout.rdbuf(nullptr);
+    holdTwoSeats();
+    std::cout.rdbuf(console);
+
+    std::filesystem::current_path(previous);
+    std::filesystem::remove_all(scratch);
+    if (failures > 0) {
+        std::cerr << failures << " check(s) failed" << std::endl;
+        return 1;
+    }
+    std::cerr << "Seat holds survived every reload." << std::endl;
+    return 0;
+}